@@ -173,6 +173,13 @@ URL
   to be avoided altogether if the local directory already has a file from
   an earlier download that matches the specified hash.
 
+  .. versionadded:: 4.5
+    If the :variable:`CMAKE_DOWNLOAD_CACHE` variable or the
+    :envvar:`CMAKE_DOWNLOAD_CACHE` environment variable is set, the
+    archive is taken from or added to that download cache.  In this
+    case the hash is verified by :command:`file(DOWNLOAD)` and a
+    mismatch is an error rather than a reason to try the next URL.
+
 ``URL_MD5 <md5>``
   Equivalent to ``URL_HASH MD5=<md5>``.
 
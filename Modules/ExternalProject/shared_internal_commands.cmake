@@ -611,6 +611,25 @@ function(_ep_write_downloadfile_script
     set(EXPECT_VALUE "")
   endif()
 
+  # Let file(DOWNLOAD) verify the hash itself if a download cache is
+  # configured so that it can use and populate the cache.
+  set(DOWNLOAD_CACHE_CODE "")
+  set(EXPECTED_HASH_ARGS "")
+  if(NOT "x${CMAKE_DOWNLOAD_CACHE}" STREQUAL "x")
+    set(download_cache "${CMAKE_DOWNLOAD_CACHE}")
+  else()
+    set(download_cache "$ENV{CMAKE_DOWNLOAD_CACHE}")
+  endif()
+  if(NOT "x${download_cache}" STREQUAL "x" AND NOT "x${ALGO}" STREQUAL "x")
+    cmake_path(ABSOLUTE_PATH download_cache
+      BASE_DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}"
+    )
+    set(DOWNLOAD_CACHE_CODE
+      "set(CMAKE_DOWNLOAD_CACHE \"${download_cache}\")"
+    )
+    set(EXPECTED_HASH_ARGS "EXPECTED_HASH ${ALGO}=${EXPECT_VALUE}")
+  endif()
+
   set(TLS_VERSION_CODE "")
   if(NOT "x${tls_version}" STREQUAL "x")
     set(TLS_VERSION_CODE "set(CMAKE_TLS_VERSION \"${tls_version}\")")
@@ -652,6 +671,8 @@ function(_ep_write_downloadfile_script
   endif()
 
   # Used variables:
+  # * DOWNLOAD_CACHE_CODE
+  # * EXPECTED_HASH_ARGS
   # * TLS_VERSION_CODE
   # * TLS_VERIFY_CODE
   # * TLS_CAINFO_CODE
@@ -0,0 +1,88 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+#include "cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool.h"
+
+#include <unordered_map>
+#include <utility>
+
+#include "cmELF.h"
+#include "cmFileTime.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+namespace {
+struct FileInfo
+{
+  cmSystemTools::FileId Id;
+  unsigned long long Size = 0;
+  cmFileTime ModifiedTime;
+  std::vector<std::string> Needed;
+  std::vector<std::string> RPaths;
+  std::vector<std::string> RunPaths;
+};
+
+// The same libraries are typically visited by every
+// file(GET_RUNTIME_DEPENDENCIES) call of an installation.
+std::unordered_map<std::string, FileInfo> FileInfoCache;
+}
+
+cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool::
+  cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool(
+    cmRuntimeDependencyArchive* archive)
+  : cmBinUtilsLinuxELFGetRuntimeDependenciesTool(archive)
+{
+}
+
+bool cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool::GetFileInfo(
+  std::string const& file, std::vector<std::string>& needed,
+  std::vector<std::string>& rpaths, std::vector<std::string>& runpaths)
+{
+  cmSystemTools::FileId id;
+  if (!cmSystemTools::GetFileId(file, id)) {
+    this->SetError(cmStrCat("Failed to stat:\n  ", file));
+    return false;
+  }
+  // Compare the size explicitly since not every platform's FileId has it,
+  // and the modification time at full resolution to catch quick rewrites.
+  unsigned long long const size = cmSystemTools::FileLength(file);
+  cmFileTime modifiedTime;
+  if (!modifiedTime.Load(file)) {
+    this->SetError(cmStrCat("Failed to stat:\n  ", file));
+    return false;
+  }
+
+  auto it = FileInfoCache.find(file);
+  if (it == FileInfoCache.end() || it->second.Id != id ||
+      it->second.Size != size ||
+      it->second.ModifiedTime.Differ(modifiedTime)) {
+    FileInfo info;
+    info.Id = id;
+    info.Size = size;
+    info.ModifiedTime = modifiedTime;
+
+    cmELF elf(file.c_str());
+    if (elf) {
+      info.Needed = elf.GetNeeded();
+      if (cmELF::StringEntry const* se = elf.GetRPath()) {
+        info.RPaths = cmSystemTools::SplitString(se->Value, ':');
+      }
+      if (cmELF::StringEntry const* se = elf.GetRunPath()) {
+        info.RunPaths = cmSystemTools::SplitString(se->Value, ':');
+      }
+    }
+    if (!elf) {
+      this->SetError(cmStrCat("Failed to read ELF file:\n  ", file, "\n",
+                              elf.GetErrorMessage()));
+      return false;
+    }
+    FileInfoCache[file] = std::move(info);
+    it = FileInfoCache.find(file);
+  }
+
+  FileInfo const& info = it->second;
+  needed.insert(needed.end(), info.Needed.begin(), info.Needed.end());
+  rpaths.insert(rpaths.end(), info.RPaths.begin(), info.RPaths.end());
+  runpaths.insert(runpaths.end(), info.RunPaths.begin(), info.RunPaths.end());
+  return true;
+}
@@ -0,0 +1,32 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cmBinUtilsLinuxELFGetRuntimeDependenciesTool.h"
+
+class cmRuntimeDependencyArchive;
+
+/** \class cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool
+ * \brief Read the dynamic section of ELF files with cmELF.
+ *
+ * Unlike the objdump tool, no process is spawned per file.  Results are
+ * kept for the lifetime of the process and reused for files whose device,
+ * inode, size and modification time (at the resolution the file system
+ * records) have not changed.  The ld.so cache is not cached; it is read
+ * once per file(GET_RUNTIME_DEPENDENCIES) call.
+ */
+class cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool
+  : public cmBinUtilsLinuxELFGetRuntimeDependenciesTool
+{
+public:
+  cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool(
+    cmRuntimeDependencyArchive* archive);
+
+  bool GetFileInfo(std::string const& file, std::vector<std::string>& needed,
+                   std::vector<std::string>& rpaths,
+                   std::vector<std::string>& runpaths) override;
+};
@@ -13,9 +13,11 @@
 
 #include <cmsys/RegularExpression.hxx>
 
+#include "cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool.h"
 #include "cmBinUtilsLinuxELFObjdumpGetRuntimeDependenciesTool.h"
 #include "cmELF.h"
 #include "cmLDConfigLDConfigTool.h"
+#include "cmLDConfigLDSOCacheTool.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
 #include "cmRuntimeDependencyArchive.h"
@@ -61,6 +63,10 @@ bool cmBinUtilsLinuxELFLinker::Prepare()
     this->Tool =
       cm::make_unique<cmBinUtilsLinuxELFObjdumpGetRuntimeDependenciesTool>(
         this->Archive);
+  } else if (tool == "builtin") {
+    this->Tool =
+      cm::make_unique<cmBinUtilsLinuxELFBuiltinGetRuntimeDependenciesTool>(
+        this->Archive);
   } else {
     std::ostringstream e;
     e << "Invalid value for CMAKE_GET_RUNTIME_DEPENDENCIES_TOOL: " << tool;
@@ -71,20 +77,30 @@ bool cmBinUtilsLinuxELFLinker::Prepare()
   std::string ldConfigTool =
     this->Archive->GetMakefile()->GetSafeDefinition("CMAKE_LDCONFIG_TOOL");
   if (ldConfigTool.empty()) {
-    ldConfigTool = "ldconfig";
+    // The builtin tool avoids spawning processes, so prefer reading the
+    // ld.so cache directly when there is one.
+    if (tool == "builtin" &&
+        cmSystemTools::FileExists(cmLDConfigLDSOCacheTool::CacheFile, true)) {
+      ldConfigTool = "ld.so.cache";
+    } else {
+      ldConfigTool = "ldconfig";
+    }
   }
   if (ldConfigTool == "ldconfig") {
     this->LDConfigTool =
       cm::make_unique<cmLDConfigLDConfigTool>(this->Archive);
-    if (!this->LDConfigTool->GetLDConfigPaths(this->LDConfigPaths)) {
-      return false;
-    }
+  } else if (ldConfigTool == "ld.so.cache") {
+    this->LDConfigTool =
+      cm::make_unique<cmLDConfigLDSOCacheTool>(this->Archive);
   } else {
     std::ostringstream e;
     e << "Invalid value for CMAKE_LDCONFIG_TOOL: " << ldConfigTool;
     this->SetError(e.str());
     return false;
   }
+  if (!this->LDConfigTool->GetLDConfigPaths(this->LDConfigPaths)) {
+    return false;
+  }
 
   return true;
 }
@@ -17,6 +17,7 @@
 #include "cmGeneratorExpression.h"
 #include "cmMakefile.h"
 #include "cmPolicies.h"
+#include "cmRegexCache.h"
 #include "cmStringAlgorithms.h"
 #include "cmStringReplaceHelper.h"
 #include "cmSystemTools.h"
@@ -85,7 +86,7 @@ cmList CMakeString::Match(std::string const& matchExpression,
 
   // Compile the regular expression.
   cmsys::RegularExpression re;
-  if (!re.compile(matchExpression)) {
+  if (!cmRegexCache::Compile(re, matchExpression)) {
     throw std::invalid_argument(
       cmStrCat("Failed to compile regex \"", matchExpression, '"'));
   }
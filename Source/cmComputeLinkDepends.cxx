@@ -5,8 +5,8 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
-#include <iterator>
 #include <sstream>
 #include <unordered_map>
 #include <utility>
@@ -764,6 +764,7 @@ cmComputeLinkDepends::AllocateLinkEntry(cmLinkItem const& item)
   if (lei.second) {
     this->EntryList.emplace_back();
     this->InferredDependSets.emplace_back();
+    this->SharedDepFollowed.push_back(false);
     this->EntryConstraintGraph.emplace_back();
   }
   return lei;
@@ -884,7 +885,8 @@ void cmComputeLinkDepends::FollowSharedDeps(size_t depender_index,
                                             bool follow_interface)
 {
   // Follow dependencies if we have not followed them already.
-  if (this->SharedDepFollowed.insert(depender_index).second) {
+  if (!this->SharedDepFollowed[depender_index]) {
+    this->SharedDepFollowed[depender_index] = true;
     if (follow_interface) {
       this->QueueSharedDependencies(depender_index, iface->Libraries);
     }
@@ -1267,7 +1269,7 @@ void cmComputeLinkDepends::AddLinkEntries(cm::optional<size_t> depender_index,
               this->EntryList[index].Kind != LinkEntry::Flag &&
               this->EntryList[index].Kind != LinkEntry::Group &&
               dependee_index != dependSet.first) {
-            dependSet.second.insert(index);
+            dependSet.second.Insert(index);
           }
         }
 
@@ -1324,21 +1326,52 @@ void cmComputeLinkDepends::InferDependencies()
     // Intersect the sets for this item.
     DependSet common = sets.front();
     for (DependSet const& i : cmMakeRange(sets).advance(1)) {
-      DependSet intersection;
-      std::set_intersection(common.begin(), common.end(), i.begin(), i.end(),
-                            std::inserter(intersection, intersection.begin()));
-      common = intersection;
+      common.Intersect(i);
     }
 
     // Add the inferred dependencies to the graph.
+    std::vector<size_t> const indices = common.GetIndices();
     cmGraphEdgeList& edges = this->EntryConstraintGraph[depender_index];
-    edges.reserve(edges.size() + common.size());
-    for (auto const& c : common) {
+    edges.reserve(edges.size() + indices.size());
+    for (size_t c : indices) {
       edges.emplace_back(c, true, false, cmListFileBacktrace());
     }
   }
 }
 
+void cmComputeLinkDepends::DependSet::Insert(size_t index)
+{
+  size_t const word = index / 64;
+  if (word >= this->Bits.size()) {
+    this->Bits.resize(word + 1, 0);
+  }
+  this->Bits[word] |= std::uint64_t(1) << (index % 64);
+}
+
+void cmComputeLinkDepends::DependSet::Intersect(DependSet const& other)
+{
+  if (this->Bits.size() > other.Bits.size()) {
+    this->Bits.resize(other.Bits.size());
+  }
+  for (size_t i = 0; i < this->Bits.size(); ++i) {
+    this->Bits[i] &= other.Bits[i];
+  }
+}
+
+std::vector<size_t> cmComputeLinkDepends::DependSet::GetIndices() const
+{
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < this->Bits.size(); ++i) {
+    std::uint64_t const bits = this->Bits[i];
+    for (size_t bit = 0; bit < 64 && (bits >> bit); ++bit) {
+      if ((bits >> bit) & 1) {
+        indices.push_back(i * 64 + bit);
+      }
+    }
+  }
+  return indices;
+}
+
 void cmComputeLinkDepends::UpdateGroupDependencies()
 {
   if (this->GroupItems.empty()) {
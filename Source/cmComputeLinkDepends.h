@@ -5,6 +5,7 @@
 #include "cmConfigure.h" // IWYU pragma: keep
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <queue>
@@ -143,16 +144,25 @@ private:
     size_t DependerIndex;
   };
   std::queue<SharedDepEntry> SharedDepQueue;
-  std::set<size_t> SharedDepFollowed;
+  std::vector<bool> SharedDepFollowed;
   void FollowSharedDeps(size_t depender_index, cmLinkInterface const* iface,
                         bool follow_interface = false);
   void QueueSharedDependencies(size_t depender_index,
                                std::vector<cmLinkItem> const& deps);
   void HandleSharedDependency(SharedDepEntry const& dep);
 
-  // Dependency inferral for each link item.
-  struct DependSet : public std::set<size_t>
+  // Dependency inferral for each link item.  Sets of entry indices are
+  // stored as bit masks so that intersecting them is cheap even when the
+  // link closure holds thousands of entries.
+  class DependSet
   {
+  public:
+    void Insert(size_t index);
+    void Intersect(DependSet const& other);
+    std::vector<size_t> GetIndices() const;
+
+  private:
+    std::vector<std::uint64_t> Bits;
   };
   struct DependSetList : public std::vector<DependSet>
   {
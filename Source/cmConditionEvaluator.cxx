@@ -8,12 +8,16 @@
 #include <functional>
 #include <iterator>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include <utility>
 
 #include <cm/optional>
 #include <cm/string_view>
 #include <cmext/algorithm>
+#include <cmext/string_view>
 
 #include "cmsys/RegularExpression.hxx"
 
@@ -23,49 +27,115 @@
 #include "cmList.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
+#include "cmRegexCache.h"
 #include "cmState.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 #include "cmValue.h"
 
 namespace {
-auto const keyAND = "AND"_s;
-auto const keyCOMMAND = "COMMAND"_s;
-auto const keyDEFINED = "DEFINED"_s;
-auto const keyDIAGNOSTIC = "DIAGNOSTIC"_s;
-auto const keyEQUAL = "EQUAL"_s;
-auto const keyEXISTS = "EXISTS"_s;
-auto const keyIS_READABLE = "IS_READABLE"_s;
-auto const keyIS_WRITABLE = "IS_WRITABLE"_s;
-auto const keyIS_EXECUTABLE = "IS_EXECUTABLE"_s;
-auto const keyGREATER = "GREATER"_s;
-auto const keyGREATER_EQUAL = "GREATER_EQUAL"_s;
-auto const keyIN_LIST = "IN_LIST"_s;
-auto const keyIS_ABSOLUTE = "IS_ABSOLUTE"_s;
-auto const keyIS_DIRECTORY = "IS_DIRECTORY"_s;
-auto const keyIS_NEWER_THAN = "IS_NEWER_THAN"_s;
-auto const keyIS_SYMLINK = "IS_SYMLINK"_s;
-auto const keyLESS = "LESS"_s;
-auto const keyLESS_EQUAL = "LESS_EQUAL"_s;
-auto const keyMATCHES = "MATCHES"_s;
-auto const keyNOT = "NOT"_s;
-auto const keyOR = "OR"_s;
-auto const keyParenL = "("_s;
-auto const keyParenR = ")"_s;
-auto const keyPOLICY = "POLICY"_s;
-auto const keySTREQUAL = "STREQUAL"_s;
-auto const keySTRGREATER = "STRGREATER"_s;
-auto const keySTRGREATER_EQUAL = "STRGREATER_EQUAL"_s;
-auto const keySTRLESS = "STRLESS"_s;
-auto const keySTRLESS_EQUAL = "STRLESS_EQUAL"_s;
-auto const keyTARGET = "TARGET"_s;
-auto const keyTEST = "TEST"_s;
-auto const keyVERSION_EQUAL = "VERSION_EQUAL"_s;
-auto const keyVERSION_GREATER = "VERSION_GREATER"_s;
-auto const keyVERSION_GREATER_EQUAL = "VERSION_GREATER_EQUAL"_s;
-auto const keyVERSION_LESS = "VERSION_LESS"_s;
-auto const keyVERSION_LESS_EQUAL = "VERSION_LESS_EQUAL"_s;
-auto const keyPATH_EQUAL = "PATH_EQUAL"_s;
+// Keywords recognized in unquoted condition arguments.  Each group of
+// comparison operators is listed in the order of MATCH2CMPOP.
+enum Keyword : unsigned char
+{
+  kwNone,
+  kwParenL,
+  kwParenR,
+  kwCOMMAND,
+  kwDEFINED,
+  kwDIAGNOSTIC,
+  kwEXISTS,
+  kwIS_ABSOLUTE,
+  kwIS_DIRECTORY,
+  kwIS_EXECUTABLE,
+  kwIS_READABLE,
+  kwIS_SYMLINK,
+  kwIS_WRITABLE,
+  kwPOLICY,
+  kwTARGET,
+  kwTEST,
+  kwMATCHES,
+  kwLESS,
+  kwLESS_EQUAL,
+  kwGREATER,
+  kwGREATER_EQUAL,
+  kwEQUAL,
+  kwSTRLESS,
+  kwSTRLESS_EQUAL,
+  kwSTRGREATER,
+  kwSTRGREATER_EQUAL,
+  kwSTREQUAL,
+  kwVERSION_LESS,
+  kwVERSION_LESS_EQUAL,
+  kwVERSION_GREATER,
+  kwVERSION_GREATER_EQUAL,
+  kwVERSION_EQUAL,
+  kwIS_NEWER_THAN,
+  kwIN_LIST,
+  kwPATH_EQUAL,
+  kwNOT,
+  kwAND,
+  kwOR
+};
+
+Keyword GetKeyword(cmExpandedCommandArgument const& argument)
+{
+  if (argument.WasQuoted()) {
+    return kwNone;
+  }
+
+  std::string const& value = argument.GetValue();
+  if (value.empty() ||
+      !(value[0] == '(' || value[0] == ')' ||
+        (value[0] >= 'A' && value[0] <= 'Z'))) {
+    return kwNone;
+  }
+
+  static std::unordered_map<cm::string_view, Keyword> const keywords{
+    { "("_s, kwParenL },
+    { ")"_s, kwParenR },
+    { "AND"_s, kwAND },
+    { "COMMAND"_s, kwCOMMAND },
+    { "DEFINED"_s, kwDEFINED },
+    { "DIAGNOSTIC"_s, kwDIAGNOSTIC },
+    { "EQUAL"_s, kwEQUAL },
+    { "EXISTS"_s, kwEXISTS },
+    { "GREATER"_s, kwGREATER },
+    { "GREATER_EQUAL"_s, kwGREATER_EQUAL },
+    { "IN_LIST"_s, kwIN_LIST },
+    { "IS_ABSOLUTE"_s, kwIS_ABSOLUTE },
+    { "IS_DIRECTORY"_s, kwIS_DIRECTORY },
+    { "IS_EXECUTABLE"_s, kwIS_EXECUTABLE },
+    { "IS_NEWER_THAN"_s, kwIS_NEWER_THAN },
+    { "IS_READABLE"_s, kwIS_READABLE },
+    { "IS_SYMLINK"_s, kwIS_SYMLINK },
+    { "IS_WRITABLE"_s, kwIS_WRITABLE },
+    { "LESS"_s, kwLESS },
+    { "LESS_EQUAL"_s, kwLESS_EQUAL },
+    { "MATCHES"_s, kwMATCHES },
+    { "NOT"_s, kwNOT },
+    { "OR"_s, kwOR },
+    { "PATH_EQUAL"_s, kwPATH_EQUAL },
+    { "POLICY"_s, kwPOLICY },
+    { "STREQUAL"_s, kwSTREQUAL },
+    { "STRGREATER"_s, kwSTRGREATER },
+    { "STRGREATER_EQUAL"_s, kwSTRGREATER_EQUAL },
+    { "STRLESS"_s, kwSTRLESS },
+    { "STRLESS_EQUAL"_s, kwSTRLESS_EQUAL },
+    { "TARGET"_s, kwTARGET },
+    { "TEST"_s, kwTEST },
+    { "VERSION_EQUAL"_s, kwVERSION_EQUAL },
+    { "VERSION_GREATER"_s, kwVERSION_GREATER },
+    { "VERSION_GREATER_EQUAL"_s, kwVERSION_GREATER_EQUAL },
+    { "VERSION_LESS"_s, kwVERSION_LESS },
+    { "VERSION_LESS_EQUAL"_s, kwVERSION_LESS_EQUAL },
+  };
+  auto const i = keywords.find(value);
+  return i != keywords.end() ? i->second : kwNone;
+}
+
+// Maximum number of distinct condition structures kept compiled.
+std::size_t const MaxPrograms = 4096;
 
 cmSystemTools::CompareOp const MATCH2CMPOP[5] = {
   cmSystemTools::OP_LESS, cmSystemTools::OP_LESS_EQUAL,
@@ -101,12 +171,6 @@ struct cmRt2CtSelector<Comp>
   }
 };
 
-std::string bool2string(bool const value)
-{
-  return std::string(static_cast<std::size_t>(1),
-                     static_cast<char>('0' + static_cast<int>(value)));
-}
-
 bool looksLikeSpecialVariable(std::string const& var,
                               cm::static_string_view prefix,
                               std::size_t const varNameLen)
@@ -118,104 +182,212 @@ bool looksLikeSpecialVariable(std::string const& var,
 }
 } // anonymous namespace
 
-#if defined(__SUNPRO_CC)
-#  define CM_INHERIT_CTOR(Class, Base, Tpl)                                   \
-    template <typename... Args>                                               \
-    Class(Args&&... args)                                                     \
-      : Base Tpl(std::forward<Args>(args)...)                                 \
-    {                                                                         \
-    }
-#else
-#  define CM_INHERIT_CTOR(Class, Base, Tpl) using Base Tpl ::Base
-#endif
-
-// BEGIN cmConditionEvaluator::cmArgumentList
-class cmConditionEvaluator::cmArgumentList
-  : public std::list<cmExpandedCommandArgument>
+// BEGIN cmConditionEvaluator::Program
+// A condition compiled from the keyword structure of its arguments.
+// Values are held in slots: the expanded arguments come first, followed
+// by one slot per intermediate result.  Each operation reads its operand
+// slots and stores its boolean result in a new slot, in the same order in
+// which the reductions of the condition are performed.
+class cmConditionEvaluator::Program
 {
-  using base_t = std::list<cmExpandedCommandArgument>;
-
 public:
-  CM_INHERIT_CTOR(cmArgumentList, list, <cmExpandedCommandArgument>);
+  enum OpCode
+  {
+    // Predicates on the Rhs operand.
+    opExists,
+    opIsReadable,
+    opIsWritable,
+    opIsExecutable,
+    opIsDirectory,
+    opIsSymlink,
+    opIsAbsolute,
+    opCommand,
+    opDiagnostic,
+    opPolicy,
+    opTarget,
+    opDefined,
+    opTest,
+    // Binary operations on the Lhs and Rhs operands.
+    opMatches,
+    opNumeric,
+    opString,
+    opVersion,
+    opIsNewerThan,
+    opInList,
+    opPathEqual,
+    opAndOr,
+    // Boolean value of the Rhs operand, or its negation.
+    opBool,
+    opNot,
+    // A constant false result.
+    opFalse,
+    // A diagnostic that does not produce a result.
+    opWarnPathEqual,
+    // Errors that terminate the evaluation.
+    opMismatchedParenthesis,
+    opUnknownArguments
+  };
 
-  class CurrentAndNextIter
+  struct Op
   {
-    friend class cmConditionEvaluator::cmArgumentList;
+    OpCode Code;
+    // 1-based index of the operator within its group.
+    int Match;
+    std::size_t Lhs;
+    std::size_t Rhs;
+    std::size_t Out;
+  };
 
-  public:
-    base_t::iterator current;
-    base_t::iterator next;
+  std::vector<Op> Ops;
+  std::size_t Slots = 0;
+  std::size_t Result = 0;
+};
+// END cmConditionEvaluator::Program
 
-    CurrentAndNextIter advance(base_t& args)
-    {
-      this->current = std::next(this->current);
-      this->next =
-        std::next(this->current,
-                  static_cast<difference_type>(this->current != args.end()));
-      return *this;
-    }
+// BEGIN cmConditionEvaluator::ProgramCompiler
+// Compiles a condition by performing its reductions on keywords and slots
+// instead of values.  Which reductions happen depends only on which
+// arguments are keywords, since intermediate results are never keywords.
+class cmConditionEvaluator::ProgramCompiler
+{
+public:
+  ProgramCompiler(Program& program, cmPolicies::PolicyStatus policy139Status)
+    : Compiled(program)
+    , Policy139Status(policy139Status)
+  {
+  }
 
-  private:
-    CurrentAndNextIter(base_t& args)
-      : current(args.begin())
-      , next(
-          std::next(this->current,
-                    static_cast<difference_type>(this->current != args.end())))
-    {
+  void Compile(std::string const& keywords)
+  {
+    ItemList items;
+    for (char const key : keywords) {
+      items.push_back(
+        { static_cast<Keyword>(key), this->Compiled.Slots++ });
     }
+    this->Compiled.Result = this->CompileExpression(items);
+  }
+
+private:
+  static std::size_t const Failed = static_cast<std::size_t>(-1);
+
+  struct Item
+  {
+    Keyword Key;
+    std::size_t Slot;
   };
 
-  class CurrentAndTwoMoreIter
+  class ItemList : public std::list<Item>
   {
-    friend class cmConditionEvaluator::cmArgumentList;
+    using base_t = std::list<Item>;
 
   public:
-    base_t::iterator current;
-    base_t::iterator next;
-    base_t::iterator nextnext;
+    class CurrentAndNextIter
+    {
+      friend class ItemList;
+
+    public:
+      base_t::iterator current;
+      base_t::iterator next;
+
+      CurrentAndNextIter advance(base_t& args)
+      {
+        this->current = std::next(this->current);
+        this->next = std::next(
+          this->current,
+          static_cast<difference_type>(this->current != args.end()));
+        return *this;
+      }
+
+    private:
+      CurrentAndNextIter(base_t& args)
+        : current(args.begin())
+        , next(std::next(
+            this->current,
+            static_cast<difference_type>(this->current != args.end())))
+      {
+      }
+    };
 
-    CurrentAndTwoMoreIter advance(base_t& args)
+    class CurrentAndTwoMoreIter
     {
-      this->current = std::next(this->current);
-      this->next =
-        std::next(this->current,
-                  static_cast<difference_type>(this->current != args.end()));
-      this->nextnext = std::next(
-        this->next, static_cast<difference_type>(this->next != args.end()));
-      return *this;
+      friend class ItemList;
+
+    public:
+      base_t::iterator current;
+      base_t::iterator next;
+      base_t::iterator nextnext;
+
+      CurrentAndTwoMoreIter advance(base_t& args)
+      {
+        this->current = std::next(this->current);
+        this->next = std::next(
+          this->current,
+          static_cast<difference_type>(this->current != args.end()));
+        this->nextnext = std::next(
+          this->next, static_cast<difference_type>(this->next != args.end()));
+        return *this;
+      }
+
+    private:
+      CurrentAndTwoMoreIter(base_t& args)
+        : current(args.begin())
+        , next(std::next(
+            this->current,
+            static_cast<difference_type>(this->current != args.end())))
+        , nextnext(std::next(
+            this->next,
+            static_cast<difference_type>(this->next != args.end())))
+      {
+      }
+    };
+
+    CurrentAndNextIter make2ArgsIterator() { return *this; }
+    CurrentAndTwoMoreIter make3ArgsIterator() { return *this; }
+
+    template <typename Iter>
+    void ReduceOneArg(std::size_t const slot, Iter args)
+    {
+      *args.current = Item{ kwNone, slot };
+      this->erase(args.next);
     }
 
-  private:
-    CurrentAndTwoMoreIter(base_t& args)
-      : current(args.begin())
-      , next(
-          std::next(this->current,
-                    static_cast<difference_type>(this->current != args.end())))
-      , nextnext(std::next(
-          this->next, static_cast<difference_type>(this->next != args.end())))
+    void ReduceTwoArgs(std::size_t const slot, CurrentAndTwoMoreIter args)
     {
+      *args.current = Item{ kwNone, slot };
+      this->erase(args.nextnext);
+      this->erase(args.next);
     }
   };
 
-  CurrentAndNextIter make2ArgsIterator() { return *this; }
-  CurrentAndTwoMoreIter make3ArgsIterator() { return *this; }
+  std::size_t Emit(Program::OpCode code, std::size_t lhs, std::size_t rhs,
+                   int match = 0)
+  {
+    std::size_t const out = this->Compiled.Slots++;
+    this->Compiled.Ops.push_back({ code, match, lhs, rhs, out });
+    return out;
+  }
 
-  template <typename Iter>
-  void ReduceOneArg(bool const value, Iter args)
+  std::size_t EmitUnary(Program::OpCode code, std::size_t rhs)
   {
-    *args.current = cmExpandedCommandArgument(bool2string(value), true);
-    this->erase(args.next);
+    return this->Emit(code, Failed, rhs);
   }
 
-  void ReduceTwoArgs(bool const value, CurrentAndTwoMoreIter args)
+  void EmitDiagnostic(Program::OpCode code)
   {
-    *args.current = cmExpandedCommandArgument(bool2string(value), true);
-    this->erase(args.nextnext);
-    this->erase(args.next);
+    this->Compiled.Ops.push_back({ code, 0, Failed, Failed, Failed });
   }
-};
 
-// END cmConditionEvaluator::cmArgumentList
+  std::size_t CompileExpression(ItemList& items);
+  bool CompileLevel0(ItemList& items);
+  bool CompileLevel1(ItemList& items);
+  bool CompileLevel2(ItemList& items);
+  bool CompileLevel3(ItemList& items);
+  bool CompileLevel4(ItemList& items);
+
+  Program& Compiled;
+  cmPolicies::PolicyStatus Policy139Status;
+};
+// END cmConditionEvaluator::ProgramCompiler
 
 cmConditionEvaluator::cmConditionEvaluator(cmMakefile& makefile,
                                            cmListFileBacktrace bt)
@@ -240,6 +412,10 @@ cmConditionEvaluator::cmConditionEvaluator(cmMakefile& makefile,
 // take numeric values or variable names. STRLESS and STRGREATER take
 // variable names but if the variable name is not found it will use the name
 // directly. AND OR take variables or the values 0 or 1.
+//
+// The order of the reductions depends only on which arguments are
+// keywords, so each distinct structure is compiled once into a Program
+// that is then run against the argument values.
 
 bool cmConditionEvaluator::IsTrue(
   std::vector<cmExpandedCommandArgument> const& args, std::string& errorString,
@@ -252,173 +428,117 @@ bool cmConditionEvaluator::IsTrue(
     return false;
   }
 
-  // store the reduced args in this vector
-  cmArgumentList newArgs(args.begin(), args.end());
+  // The structure of the condition, including the policy settings that
+  // affect it, is the key of its compiled program.
+  std::string structure;
+  structure.reserve(args.size());
+  for (cmExpandedCommandArgument const& arg : args) {
+    structure += static_cast<char>(GetKeyword(arg));
+  }
+  std::string key = cmStrCat(static_cast<char>(this->Policy139Status), '\0',
+                             structure);
+
+  // Programs are shared by all evaluators.  Run them outside of the lock
+  // so that conditions evaluated concurrently do not wait for each other.
+  static std::mutex programsMutex;
+  static std::unordered_map<std::string, std::shared_ptr<Program const>>
+    programs;
+  std::shared_ptr<Program const> program;
+  {
+    std::lock_guard<std::mutex> lock(programsMutex);
+    auto const i = programs.find(key);
+    if (i != programs.end()) {
+      program = i->second;
+    }
+  }
+  if (!program) {
+    auto compiled = std::make_shared<Program>();
+    ProgramCompiler(*compiled, this->Policy139Status).Compile(structure);
+    program = std::move(compiled);
+    // Once the bound is reached, further structures are compiled on
+    // every evaluation instead of being kept.
+    std::lock_guard<std::mutex> lock(programsMutex);
+    if (programs.size() < MaxPrograms) {
+      programs.emplace(std::move(key), program);
+    }
+  }
+  return this->Run(*program, args, errorString, status);
+}
+
+//=========================================================================
+std::size_t cmConditionEvaluator::ProgramCompiler::CompileExpression(
+  ItemList& items)
+{
+  // handle empty parenthetical groups
+  if (items.empty()) {
+    return this->Emit(Program::opFalse, Failed, Failed);
+  }
 
   // now loop through the arguments and see if we can reduce any of them
   // we do this multiple times. Once for each level of precedence
   // parens
-  using handlerFn_t = bool (cmConditionEvaluator::*)(
-    cmArgumentList&, std::string&, MessageType&);
+  using handlerFn_t = bool (ProgramCompiler::*)(ItemList&);
   std::array<handlerFn_t, 5> const handlers = { {
-    &cmConditionEvaluator::HandleLevel0, // parenthesis
-    &cmConditionEvaluator::HandleLevel1, // predicates
-    &cmConditionEvaluator::HandleLevel2, // binary ops
-    &cmConditionEvaluator::HandleLevel3, // NOT
-    &cmConditionEvaluator::HandleLevel4  // AND OR
+    &ProgramCompiler::CompileLevel0, // parenthesis
+    &ProgramCompiler::CompileLevel1, // predicates
+    &ProgramCompiler::CompileLevel2, // binary ops
+    &ProgramCompiler::CompileLevel3, // NOT
+    &ProgramCompiler::CompileLevel4  // AND OR
   } };
   for (auto fn : handlers) {
     // Call the reducer 'till there is anything to reduce...
     // (i.e., if after an iteration the size becomes smaller)
     auto levelResult = true;
-    for (auto beginSize = newArgs.size();
-         (levelResult = (this->*fn)(newArgs, errorString, status)) &&
-         newArgs.size() < beginSize;
-         beginSize = newArgs.size()) {
+    for (auto beginSize = items.size();
+         (levelResult = (this->*fn)(items)) && items.size() < beginSize;
+         beginSize = items.size()) {
     }
 
     if (!levelResult) {
-      // NOTE `errorString` supposed to be set already
-      return false;
+      // NOTE the error has been emitted already
+      return Failed;
     }
   }
 
   // now at the end there should only be one argument left
-  if (newArgs.size() != 1) {
-    errorString = "Unknown arguments specified";
-    status = MessageType::FATAL_ERROR;
-    return false;
-  }
-
-  return this->GetBooleanValue(newArgs.front());
-}
-
-//=========================================================================
-cmValue cmConditionEvaluator::GetDefinitionIfUnquoted(
-  cmExpandedCommandArgument const& argument) const
-{
-  if (argument.WasQuoted()) {
-    return nullptr;
-  }
-
-  return this->Makefile.GetDefinition(argument.GetValue());
-}
-
-//=========================================================================
-cmValue cmConditionEvaluator::GetVariableOrString(
-  cmExpandedCommandArgument const& argument) const
-{
-  cmValue def = this->GetDefinitionIfUnquoted(argument);
-
-  if (!def) {
-    def = cmValue(argument.GetValue());
-  }
-
-  return def;
-}
-
-//=========================================================================
-bool cmConditionEvaluator::IsKeyword(
-  cm::static_string_view keyword,
-  cmExpandedCommandArgument const& argument) const
-{
-  if (argument.WasQuoted()) {
-    return false;
+  if (items.size() != 1) {
+    this->EmitDiagnostic(Program::opUnknownArguments);
+    return Failed;
   }
 
-  return argument.GetValue() == keyword;
-}
-
-//=========================================================================
-bool cmConditionEvaluator::GetBooleanValue(
-  cmExpandedCommandArgument& arg) const
-{
-  // Check basic and named constants.
-  if (cmIsOn(arg.GetValue())) {
-    return true;
-  }
-  if (cmIsOff(arg.GetValue())) {
-    return false;
-  }
-
-  // Check for numbers.
-  if (!arg.empty()) {
-    char* end;
-    double const d = std::strtod(arg.GetValue().c_str(), &end);
-    if (*end == '\0') {
-      // The whole string is a number.  Use C conversion to bool.
-      return static_cast<bool>(d);
-    }
-  }
-
-  // Check definition.
-  cmValue def = this->GetDefinitionIfUnquoted(arg);
-  return !def.IsOff();
-}
-
-template <int N>
-inline int cmConditionEvaluator::matchKeysImpl(
-  cmExpandedCommandArgument const&)
-{
-  // Zero means "not found"
-  return 0;
-}
-
-template <int N, typename T, typename... Keys>
-inline int cmConditionEvaluator::matchKeysImpl(
-  cmExpandedCommandArgument const& arg, T current, Keys... key)
-{
-  if (this->IsKeyword(current, arg)) {
-    // Stop searching as soon as smth has found
-    return N;
-  }
-  return matchKeysImpl<N + 1>(arg, key...);
-}
-
-template <typename... Keys>
-inline int cmConditionEvaluator::matchKeys(
-  cmExpandedCommandArgument const& arg, Keys... key)
-{
-  // Get index of the matched key (1-based)
-  return matchKeysImpl<1>(arg, key...);
+  return this->EmitUnary(Program::opBool, items.front().Slot);
 }
 
 //=========================================================================
 // level 0 processes parenthetical expressions
-bool cmConditionEvaluator::HandleLevel0(cmArgumentList& newArgs,
-                                        std::string& errorString,
-                                        MessageType& status)
+bool cmConditionEvaluator::ProgramCompiler::CompileLevel0(ItemList& items)
 {
-  for (auto arg = newArgs.begin(); arg != newArgs.end(); ++arg) {
-    if (this->IsKeyword(keyParenL, *arg)) {
+  for (auto arg = items.begin(); arg != items.end(); ++arg) {
+    if (arg->Key == kwParenL) {
       // search for the closing paren for this opening one
       auto depth = 1;
       auto argClose = std::next(arg);
-      for (; argClose != newArgs.end() && depth; ++argClose) {
-        depth += int(this->IsKeyword(keyParenL, *argClose)) -
-          int(this->IsKeyword(keyParenR, *argClose));
+      for (; argClose != items.end() && depth; ++argClose) {
+        depth +=
+          int(argClose->Key == kwParenL) - int(argClose->Key == kwParenR);
       }
       if (depth) {
-        errorString = "mismatched parenthesis in condition";
-        status = MessageType::FATAL_ERROR;
+        this->EmitDiagnostic(Program::opMismatchedParenthesis);
         return false;
       }
 
-      // store the reduced args in this vector
+      // now recursively compile the parenthetical expression
       auto argOpen = std::next(arg);
-      std::vector<cmExpandedCommandArgument> const subExpr(
-        argOpen, std::prev(argClose));
-
-      // now recursively invoke IsTrue to handle the values inside the
-      // parenthetical expression
-      auto const value = this->IsTrue(subExpr, errorString, status);
-      if (!errorString.empty()) {
+      ItemList subExpr;
+      subExpr.insert(subExpr.end(), argOpen, std::prev(argClose));
+      auto const value = this->CompileExpression(subExpr);
+      if (value == Failed) {
         return false;
       }
-      *arg = cmExpandedCommandArgument(bool2string(value), true);
+      *arg = Item{ kwNone, value };
       argOpen = std::next(arg);
       // remove the now evaluated parenthetical expression
-      newArgs.erase(argOpen, argClose);
+      items.erase(argOpen, argClose);
     }
   }
   return true;
@@ -426,299 +546,433 @@ bool cmConditionEvaluator::HandleLevel0(cmArgumentList& newArgs,
 
 //=========================================================================
 // level one handles most predicates except for NOT
-bool cmConditionEvaluator::HandleLevel1(cmArgumentList& newArgs, std::string&,
-                                        MessageType&)
+bool cmConditionEvaluator::ProgramCompiler::CompileLevel1(ItemList& items)
 {
-  for (auto args = newArgs.make2ArgsIterator(); args.current != newArgs.end();
-       args.advance(newArgs)) {
+  for (auto args = items.make2ArgsIterator(); args.current != items.end();
+       args.advance(items)) {
     // NOTE Fail fast: All the predicates below require the next arg to be
     // valid
-    if (args.next == newArgs.end()) {
+    if (args.next == items.end()) {
       continue;
     }
 
-    // does a file exist
-    if (this->IsKeyword(keyEXISTS, *args.current)) {
-      newArgs.ReduceOneArg(cmSystemTools::FileExists(args.next->GetValue()),
-                           args);
-    }
-    // check if a file is readable
-    else if (this->IsKeyword(keyIS_READABLE, *args.current)) {
-      newArgs.ReduceOneArg(cmSystemTools::TestFileAccess(
-                             args.next->GetValue(), cmsys::TEST_FILE_READ),
-                           args);
-    }
-    // check if a file is writable
-    else if (this->IsKeyword(keyIS_WRITABLE, *args.current)) {
-      newArgs.ReduceOneArg(cmSystemTools::TestFileAccess(
-                             args.next->GetValue(), cmsys::TEST_FILE_WRITE),
-                           args);
-    }
-    // check if a file is executable
-    else if (this->IsKeyword(keyIS_EXECUTABLE, *args.current)) {
-      newArgs.ReduceOneArg(cmSystemTools::TestFileAccess(
-                             args.next->GetValue(), cmsys::TEST_FILE_EXECUTE),
-                           args);
-    }
-    // does a directory with this name exist
-    else if (this->IsKeyword(keyIS_DIRECTORY, *args.current)) {
-      newArgs.ReduceOneArg(
-        cmSystemTools::FileIsDirectory(args.next->GetValue()), args);
-    }
-    // does a symlink with this name exist
-    else if (this->IsKeyword(keyIS_SYMLINK, *args.current)) {
-      newArgs.ReduceOneArg(cmSystemTools::FileIsSymlink(args.next->GetValue()),
-                           args);
-    }
-    // is the given path an absolute path ?
-    else if (this->IsKeyword(keyIS_ABSOLUTE, *args.current)) {
-      newArgs.ReduceOneArg(
-        cmSystemTools::FileIsFullPath(args.next->GetValue()), args);
-    }
-    // does a command exist
-    else if (this->IsKeyword(keyCOMMAND, *args.current)) {
-      newArgs.ReduceOneArg(
-        static_cast<bool>(
-          this->Makefile.GetState()->GetCommand(args.next->GetValue())),
-        args);
-    }
-    // does a diagnostic exist
-    else if (this->IsKeyword(keyDIAGNOSTIC, *args.current)) {
-      newArgs.ReduceOneArg(
-        cmDiagnostics::GetDiagnosticCategory(args.next->GetValue())
-          .has_value(),
-        args);
-    }
-    // does a policy exist
-    else if (this->IsKeyword(keyPOLICY, *args.current)) {
-      cmPolicies::PolicyID pid;
-      newArgs.ReduceOneArg(
-        cmPolicies::GetPolicyID(args.next->GetValue().c_str(), pid), args);
-    }
-    // does a target exist
-    else if (this->IsKeyword(keyTARGET, *args.current)) {
-      newArgs.ReduceOneArg(static_cast<bool>(this->Makefile.FindTargetToUse(
-                             args.next->GetValue())),
-                           args);
-    }
-    // is a variable defined
-    else if (this->IsKeyword(keyDEFINED, *args.current)) {
-      auto const& var = args.next->GetValue();
-      auto const varNameLen = var.size();
-
-      auto result = false;
-      if (looksLikeSpecialVariable(var, "ENV"_s, varNameLen)) {
-        auto const env = args.next->GetValue().substr(4, varNameLen - 5);
-        result = cmSystemTools::HasEnv(env);
-      }
-
-      else if (looksLikeSpecialVariable(var, "CACHE"_s, varNameLen)) {
-        auto const cache = args.next->GetValue().substr(6, varNameLen - 7);
-        result = static_cast<bool>(
-          this->Makefile.GetState()->GetCacheEntryValue(cache));
-      }
-
-      else {
-        result = this->Makefile.IsDefinitionSet(args.next->GetValue());
-      }
-      newArgs.ReduceOneArg(result, args);
-    }
-    // does a test exist
-    else if (this->IsKeyword(keyTEST, *args.current)) {
-      newArgs.ReduceOneArg(
-        static_cast<bool>(this->Makefile.GetTest(args.next->GetValue())),
-        args);
+    Program::OpCode code;
+    switch (args.current->Key) {
+      case kwEXISTS:
+        code = Program::opExists;
+        break;
+      case kwIS_READABLE:
+        code = Program::opIsReadable;
+        break;
+      case kwIS_WRITABLE:
+        code = Program::opIsWritable;
+        break;
+      case kwIS_EXECUTABLE:
+        code = Program::opIsExecutable;
+        break;
+      case kwIS_DIRECTORY:
+        code = Program::opIsDirectory;
+        break;
+      case kwIS_SYMLINK:
+        code = Program::opIsSymlink;
+        break;
+      case kwIS_ABSOLUTE:
+        code = Program::opIsAbsolute;
+        break;
+      case kwCOMMAND:
+        code = Program::opCommand;
+        break;
+      case kwDIAGNOSTIC:
+        code = Program::opDiagnostic;
+        break;
+      case kwPOLICY:
+        code = Program::opPolicy;
+        break;
+      case kwTARGET:
+        code = Program::opTarget;
+        break;
+      case kwDEFINED:
+        code = Program::opDefined;
+        break;
+      case kwTEST:
+        code = Program::opTest;
+        break;
+      default:
+        continue;
     }
+    items.ReduceOneArg(this->EmitUnary(code, args.next->Slot), args);
   }
   return true;
 }
 
 //=========================================================================
 // level two handles most binary operations except for AND  OR
-bool cmConditionEvaluator::HandleLevel2(cmArgumentList& newArgs,
-                                        std::string& errorString,
-                                        MessageType& status)
+bool cmConditionEvaluator::ProgramCompiler::CompileLevel2(ItemList& items)
 {
-  for (auto args = newArgs.make3ArgsIterator(); args.current != newArgs.end();
-       args.advance(newArgs)) {
-
-    int matchNo;
+  for (auto args = items.make3ArgsIterator(); args.current != items.end();
+       args.advance(items)) {
 
     // NOTE Handle special case `if(... BLAH_BLAH MATCHES)`
     // (i.e., w/o regex to match which is possibly result of
     // variable expansion to an empty string)
-    if (args.next != newArgs.end() &&
-        this->IsKeyword(keyMATCHES, *args.current)) {
-      newArgs.ReduceOneArg(false, args);
+    if (args.next != items.end() && args.current->Key == kwMATCHES) {
+      items.ReduceOneArg(this->Emit(Program::opFalse, Failed, Failed), args);
+      continue;
     }
 
     // NOTE Fail fast: All the binary ops below require 2 arguments.
-    else if (args.next == newArgs.end() || args.nextnext == newArgs.end()) {
+    if (args.next == items.end() || args.nextnext == items.end()) {
       continue;
     }
 
-    else if (this->IsKeyword(keyMATCHES, *args.next)) {
-      cmValue def = this->GetDefinitionIfUnquoted(*args.current);
-
-      std::string def_buf;
-      if (!def) {
-        def = cmValue(args.current->GetValue());
-      } else if (cmHasLiteralPrefix(args.current->GetValue(),
-                                    "CMAKE_MATCH_")) {
-        // The string to match is owned by our match result variables.
-        // Move it to our own buffer before clearing them.
-        def_buf = *def;
-        def = cmValue(def_buf);
-      }
-
-      this->Makefile.ClearMatches();
-
-      auto const& rex = args.nextnext->GetValue();
-      cmsys::RegularExpression regEntry;
-      if (!regEntry.compile(rex)) {
-        std::ostringstream error;
-        error << "Regular expression \"" << rex << "\" cannot compile";
-        errorString = error.str();
-        status = MessageType::FATAL_ERROR;
-        return false;
+    Program::OpCode code;
+    int match = 0;
+    Keyword const key = args.next->Key;
+    if (key == kwMATCHES) {
+      code = Program::opMatches;
+    } else if (key >= kwLESS && key <= kwEQUAL) {
+      code = Program::opNumeric;
+      match = key - kwLESS + 1;
+    } else if (key >= kwSTRLESS && key <= kwSTREQUAL) {
+      code = Program::opString;
+      match = key - kwSTRLESS + 1;
+    } else if (key >= kwVERSION_LESS && key <= kwVERSION_EQUAL) {
+      code = Program::opVersion;
+      match = key - kwVERSION_LESS + 1;
+    } else if (key == kwIS_NEWER_THAN) {
+      code = Program::opIsNewerThan;
+    } else if (key == kwIN_LIST) {
+      code = Program::opInList;
+    } else if (key == kwPATH_EQUAL) {
+      if (this->Policy139Status == cmPolicies::WARN) {
+        this->EmitDiagnostic(Program::opWarnPathEqual);
       }
-
-      auto const match = regEntry.find(*def);
-      if (match) {
-        this->Makefile.StoreMatches(regEntry);
+      if (this->Policy139Status == cmPolicies::OLD ||
+          this->Policy139Status == cmPolicies::WARN) {
+        continue;
       }
-      newArgs.ReduceTwoArgs(match, args);
-    }
-
-    else if ((matchNo =
-                this->matchKeys(*args.next, keyLESS, keyLESS_EQUAL, keyGREATER,
-                                keyGREATER_EQUAL, keyEQUAL))) {
-
-      cmValue ldef = this->GetVariableOrString(*args.current);
-      cmValue rdef = this->GetVariableOrString(*args.nextnext);
-
-      double lhs;
-      double rhs;
-      auto parseDoubles = [&]() {
-        return std::sscanf(ldef->c_str(), "%lg", &lhs) == 1 &&
-          std::sscanf(rdef->c_str(), "%lg", &rhs) == 1;
-      };
-      // clang-format off
-      const auto result = parseDoubles() &&
-        cmRt2CtSelector<
-            std::less, std::less_equal,
-            std::greater, std::greater_equal,
-            std::equal_to
-          >::eval(matchNo, lhs, rhs);
-      // clang-format on
-      newArgs.ReduceTwoArgs(result, args);
-    }
-
-    else if ((matchNo = this->matchKeys(*args.next, keySTRLESS,
-                                        keySTRLESS_EQUAL, keySTRGREATER,
-                                        keySTRGREATER_EQUAL, keySTREQUAL))) {
-
-      cmValue const lhs = this->GetVariableOrString(*args.current);
-      cmValue const rhs = this->GetVariableOrString(*args.nextnext);
-      auto const val = (*lhs).compare(*rhs);
-      // clang-format off
-      const auto result = cmRt2CtSelector<
-            std::less, std::less_equal,
-            std::greater, std::greater_equal,
-            std::equal_to
-          >::eval(matchNo, val, 0);
-      // clang-format on
-      newArgs.ReduceTwoArgs(result, args);
-    }
-
-    else if ((matchNo =
-                this->matchKeys(*args.next, keyVERSION_LESS,
-                                keyVERSION_LESS_EQUAL, keyVERSION_GREATER,
-                                keyVERSION_GREATER_EQUAL, keyVERSION_EQUAL))) {
-      auto const op = MATCH2CMPOP[matchNo - 1];
-      cmValue const lhs = this->GetVariableOrString(*args.current);
-      cmValue const rhs = this->GetVariableOrString(*args.nextnext);
-      auto const result = cmSystemTools::VersionCompare(op, lhs, rhs);
-      newArgs.ReduceTwoArgs(result, args);
+      code = Program::opPathEqual;
+    } else {
+      continue;
     }
+    items.ReduceTwoArgs(
+      this->Emit(code, args.current->Slot, args.nextnext->Slot, match), args);
+  }
+  return true;
+}
 
-    // is file A newer than file B
-    else if (this->IsKeyword(keyIS_NEWER_THAN, *args.next)) {
-      auto fileIsNewer = 0;
-      cmsys::Status ftcStatus = cmSystemTools::FileTimeCompare(
-        args.current->GetValue(), args.nextnext->GetValue(), &fileIsNewer);
-      newArgs.ReduceTwoArgs(
-        (!ftcStatus || fileIsNewer == 1 || fileIsNewer == 0), args);
+//=========================================================================
+// level 3 handles NOT
+bool cmConditionEvaluator::ProgramCompiler::CompileLevel3(ItemList& items)
+{
+  for (auto args = items.make2ArgsIterator(); args.next != items.end();
+       args.advance(items)) {
+    if (args.current->Key == kwNOT) {
+      items.ReduceOneArg(this->EmitUnary(Program::opNot, args.next->Slot),
+                         args);
     }
+  }
+  return true;
+}
 
-    else if (this->IsKeyword(keyIN_LIST, *args.next)) {
-      cmValue lhs = this->GetVariableOrString(*args.current);
-      cmValue rhs = this->Makefile.GetDefinition(args.nextnext->GetValue());
-
-      newArgs.ReduceTwoArgs(
-        rhs && cm::contains(cmList{ *rhs, cmList::EmptyElements::Yes }, *lhs),
-        args);
+//=========================================================================
+// level 4 handles AND OR
+bool cmConditionEvaluator::ProgramCompiler::CompileLevel4(ItemList& items)
+{
+  for (auto args = items.make3ArgsIterator(); args.nextnext != items.end();
+       args.advance(items)) {
+    Keyword const key = args.next->Key;
+    if (key == kwAND || key == kwOR) {
+      items.ReduceTwoArgs(this->Emit(Program::opAndOr, args.current->Slot,
+                                     args.nextnext->Slot, key - kwAND + 1),
+                          args);
     }
+  }
+  return true;
+}
 
-    else if (this->IsKeyword(keyPATH_EQUAL, *args.next)) {
-
-      if (this->Policy139Status != cmPolicies::OLD &&
-          this->Policy139Status != cmPolicies::WARN) {
+//=========================================================================
+bool cmConditionEvaluator::Run(
+  Program const& program, std::vector<cmExpandedCommandArgument> const& args,
+  std::string& errorString, MessageType& status)
+{
+  static cmExpandedCommandArgument const argFalse("0", true);
+  static cmExpandedCommandArgument const argTrue("1", true);
 
-        cmValue lhs = this->GetVariableOrString(*args.current);
-        cmValue rhs = this->GetVariableOrString(*args.nextnext);
-        auto const result = cmCMakePath{ *lhs } == cmCMakePath{ *rhs };
-        newArgs.ReduceTwoArgs(result, args);
-      }
+  std::vector<cmExpandedCommandArgument const*> slots(program.Slots);
+  for (std::size_t i = 0; i < args.size(); ++i) {
+    slots[i] = &args[i];
+  }
 
-      else if (this->Policy139Status == cmPolicies::WARN) {
+  for (Program::Op const& op : program.Ops) {
+    bool result = false;
+    switch (op.Code) {
+      // does a file exist
+      case Program::opExists:
+        result = cmSystemTools::FileExists(slots[op.Rhs]->GetValue());
+        break;
+      // check if a file is readable
+      case Program::opIsReadable:
+        result = cmSystemTools::TestFileAccess(slots[op.Rhs]->GetValue(),
+                                               cmsys::TEST_FILE_READ);
+        break;
+      // check if a file is writable
+      case Program::opIsWritable:
+        result = cmSystemTools::TestFileAccess(slots[op.Rhs]->GetValue(),
+                                               cmsys::TEST_FILE_WRITE);
+        break;
+      // check if a file is executable
+      case Program::opIsExecutable:
+        result = cmSystemTools::TestFileAccess(slots[op.Rhs]->GetValue(),
+                                               cmsys::TEST_FILE_EXECUTE);
+        break;
+      // does a directory with this name exist
+      case Program::opIsDirectory:
+        result = cmSystemTools::FileIsDirectory(slots[op.Rhs]->GetValue());
+        break;
+      // does a symlink with this name exist
+      case Program::opIsSymlink:
+        result = cmSystemTools::FileIsSymlink(slots[op.Rhs]->GetValue());
+        break;
+      // is the given path an absolute path ?
+      case Program::opIsAbsolute:
+        result = cmSystemTools::FileIsFullPath(slots[op.Rhs]->GetValue());
+        break;
+      // does a command exist
+      case Program::opCommand:
+        result = static_cast<bool>(
+          this->Makefile.GetState()->GetCommand(slots[op.Rhs]->GetValue()));
+        break;
+      // does a diagnostic exist
+      case Program::opDiagnostic:
+        result =
+          cmDiagnostics::GetDiagnosticCategory(slots[op.Rhs]->GetValue())
+            .has_value();
+        break;
+      // does a policy exist
+      case Program::opPolicy: {
+        cmPolicies::PolicyID pid;
+        result =
+          cmPolicies::GetPolicyID(slots[op.Rhs]->GetValue().c_str(), pid);
+      } break;
+      // does a target exist
+      case Program::opTarget:
+        result = static_cast<bool>(
+          this->Makefile.FindTargetToUse(slots[op.Rhs]->GetValue()));
+        break;
+      // is a variable defined
+      case Program::opDefined: {
+        auto const& var = slots[op.Rhs]->GetValue();
+        auto const varNameLen = var.size();
+
+        if (looksLikeSpecialVariable(var, "ENV"_s, varNameLen)) {
+          auto const env = var.substr(4, varNameLen - 5);
+          result = cmSystemTools::HasEnv(env);
+        }
+
+        else if (looksLikeSpecialVariable(var, "CACHE"_s, varNameLen)) {
+          auto const cache = var.substr(6, varNameLen - 7);
+          result = static_cast<bool>(
+            this->Makefile.GetState()->GetCacheEntryValue(cache));
+        }
+
+        else {
+          result = this->Makefile.IsDefinitionSet(var);
+        }
+      } break;
+      // does a test exist
+      case Program::opTest:
+        result = static_cast<bool>(
+          this->Makefile.GetTest(slots[op.Rhs]->GetValue()));
+        break;
+
+      case Program::opMatches: {
+        cmExpandedCommandArgument const& lhs = *slots[op.Lhs];
+        cmValue def = this->GetDefinitionIfUnquoted(lhs);
+
+        std::string def_buf;
+        if (!def) {
+          def = cmValue(lhs.GetValue());
+        } else if (cmHasLiteralPrefix(lhs.GetValue(), "CMAKE_MATCH_")) {
+          // The string to match is owned by our match result variables.
+          // Move it to our own buffer before clearing them.
+          def_buf = *def;
+          def = cmValue(def_buf);
+        }
+
+        this->Makefile.ClearMatches();
+
+        auto const& rex = slots[op.Rhs]->GetValue();
+        cmsys::RegularExpression regEntry;
+        if (!cmRegexCache::Compile(regEntry, rex)) {
+          std::ostringstream error;
+          error << "Regular expression \"" << rex << "\" cannot compile";
+          errorString = error.str();
+          status = MessageType::FATAL_ERROR;
+          return false;
+        }
+
+        result = regEntry.find(*def);
+        if (result) {
+          this->Makefile.StoreMatches(regEntry);
+        }
+      } break;
+
+      case Program::opNumeric: {
+        cmValue ldef = this->GetVariableOrString(*slots[op.Lhs]);
+        cmValue rdef = this->GetVariableOrString(*slots[op.Rhs]);
+
+        double lhs;
+        double rhs;
+        auto parseDoubles = [&]() {
+          return std::sscanf(ldef->c_str(), "%lg", &lhs) == 1 &&
+            std::sscanf(rdef->c_str(), "%lg", &rhs) == 1;
+        };
+        // clang-format off
+        result = parseDoubles() &&
+          cmRt2CtSelector<
+              std::less, std::less_equal,
+              std::greater, std::greater_equal,
+              std::equal_to
+            >::eval(op.Match, lhs, rhs);
+        // clang-format on
+      } break;
+
+      case Program::opString: {
+        cmValue const lhs = this->GetVariableOrString(*slots[op.Lhs]);
+        cmValue const rhs = this->GetVariableOrString(*slots[op.Rhs]);
+        auto const val = (*lhs).compare(*rhs);
+        // clang-format off
+        result = cmRt2CtSelector<
+              std::less, std::less_equal,
+              std::greater, std::greater_equal,
+              std::equal_to
+            >::eval(op.Match, val, 0);
+        // clang-format on
+      } break;
+
+      case Program::opVersion: {
+        auto const cmpOp = MATCH2CMPOP[op.Match - 1];
+        cmValue const lhs = this->GetVariableOrString(*slots[op.Lhs]);
+        cmValue const rhs = this->GetVariableOrString(*slots[op.Rhs]);
+        result = cmSystemTools::VersionCompare(cmpOp, lhs, rhs);
+      } break;
+
+      // is file A newer than file B
+      case Program::opIsNewerThan: {
+        auto fileIsNewer = 0;
+        cmsys::Status ftcStatus = cmSystemTools::FileTimeCompare(
+          slots[op.Lhs]->GetValue(), slots[op.Rhs]->GetValue(), &fileIsNewer);
+        result = (!ftcStatus || fileIsNewer == 1 || fileIsNewer == 0);
+      } break;
+
+      case Program::opInList: {
+        cmValue lhs = this->GetVariableOrString(*slots[op.Lhs]);
+        cmValue rhs = this->Makefile.GetDefinition(slots[op.Rhs]->GetValue());
+        result = rhs &&
+          cm::contains(cmList{ *rhs, cmList::EmptyElements::Yes }, *lhs);
+      } break;
+
+      case Program::opPathEqual: {
+        cmValue lhs = this->GetVariableOrString(*slots[op.Lhs]);
+        cmValue rhs = this->GetVariableOrString(*slots[op.Rhs]);
+        result = cmCMakePath{ *lhs } == cmCMakePath{ *rhs };
+      } break;
+
+      case Program::opAndOr: {
+        auto const lhs = this->GetBooleanValue(*slots[op.Lhs]);
+        auto const rhs = this->GetBooleanValue(*slots[op.Rhs]);
+        // clang-format off
+        result =
+          cmRt2CtSelector<
+              std::logical_and, std::logical_or
+            >::eval(op.Match, lhs, rhs);
+        // clang-format on
+      } break;
+
+      case Program::opBool:
+        result = this->GetBooleanValue(*slots[op.Rhs]);
+        break;
+
+      case Program::opNot:
+        result = !this->GetBooleanValue(*slots[op.Rhs]);
+        break;
+
+      case Program::opFalse:
+        result = false;
+        break;
+
+      case Program::opWarnPathEqual:
         this->Makefile.IssuePolicyWarning(
           cmPolicies::CMP0139, {},
           "PATH_EQUAL will be interpreted as an operator "
           "when the policy is set to NEW.  "
           "Since the policy is not set the OLD behavior will be used."_s);
-      }
+        continue;
+
+      case Program::opMismatchedParenthesis:
+        errorString = "mismatched parenthesis in condition";
+        status = MessageType::FATAL_ERROR;
+        return false;
+
+      case Program::opUnknownArguments:
+        errorString = "Unknown arguments specified";
+        status = MessageType::FATAL_ERROR;
+        return false;
     }
+    slots[op.Out] = result ? &argTrue : &argFalse;
   }
-  return true;
+
+  return slots[program.Result] == &argTrue;
 }
 
 //=========================================================================
-// level 3 handles NOT
-bool cmConditionEvaluator::HandleLevel3(cmArgumentList& newArgs, std::string&,
-                                        MessageType&)
+cmValue cmConditionEvaluator::GetDefinitionIfUnquoted(
+  cmExpandedCommandArgument const& argument) const
 {
-  for (auto args = newArgs.make2ArgsIterator(); args.next != newArgs.end();
-       args.advance(newArgs)) {
-    if (this->IsKeyword(keyNOT, *args.current)) {
-      auto const rhs = this->GetBooleanValue(*args.next);
-      newArgs.ReduceOneArg(!rhs, args);
-    }
+  if (argument.WasQuoted()) {
+    return nullptr;
   }
-  return true;
+
+  return this->Makefile.GetDefinition(argument.GetValue());
 }
 
 //=========================================================================
-// level 4 handles AND OR
-bool cmConditionEvaluator::HandleLevel4(cmArgumentList& newArgs, std::string&,
-                                        MessageType&)
+cmValue cmConditionEvaluator::GetVariableOrString(
+  cmExpandedCommandArgument const& argument) const
 {
-  for (auto args = newArgs.make3ArgsIterator(); args.nextnext != newArgs.end();
-       args.advance(newArgs)) {
-
-    int matchNo;
-
-    if ((matchNo = this->matchKeys(*args.next, keyAND, keyOR))) {
-      auto const lhs = this->GetBooleanValue(*args.current);
-      auto const rhs = this->GetBooleanValue(*args.nextnext);
-      // clang-format off
-      const auto result =
-        cmRt2CtSelector<
-            std::logical_and, std::logical_or
-          >::eval(matchNo, lhs, rhs);
-      // clang-format on
-      newArgs.ReduceTwoArgs(result, args);
+  cmValue def = this->GetDefinitionIfUnquoted(argument);
+
+  if (!def) {
+    def = cmValue(argument.GetValue());
+  }
+
+  return def;
+}
+
+//=========================================================================
+bool cmConditionEvaluator::GetBooleanValue(
+  cmExpandedCommandArgument const& arg) const
+{
+  // Check basic and named constants.
+  if (cmIsOn(arg.GetValue())) {
+    return true;
+  }
+  if (cmIsOff(arg.GetValue())) {
+    return false;
+  }
+
+  // Check for numbers.
+  if (!arg.empty()) {
+    char* end;
+    double const d = std::strtod(arg.GetValue().c_str(), &end);
+    if (*end == '\0') {
+      // The whole string is a number.  Use C conversion to bool.
+      return static_cast<bool>(d);
     }
   }
-  return true;
+
+  // Check definition.
+  cmValue def = this->GetDefinitionIfUnquoted(arg);
+  return !def.IsOff();
 }
@@ -7,8 +7,6 @@
 #include <string>
 #include <vector>
 
-#include <cmext/string_view>
-
 #include "cmListFileCache.h"
 #include "cmMessageType.h" // IWYU pragma: keep
 #include "cmPolicies.h"
@@ -29,40 +27,19 @@ public:
               std::string& errorString, MessageType& status);
 
 private:
-  class cmArgumentList;
+  class Program;
+  class ProgramCompiler;
+
+  bool Run(Program const& program,
+           std::vector<cmExpandedCommandArgument> const& args,
+           std::string& errorString, MessageType& status);
 
   cmValue GetDefinitionIfUnquoted(
     cmExpandedCommandArgument const& argument) const;
 
   cmValue GetVariableOrString(cmExpandedCommandArgument const& argument) const;
 
-  bool IsKeyword(cm::static_string_view keyword,
-                 cmExpandedCommandArgument const& argument) const;
-
-  bool GetBooleanValue(cmExpandedCommandArgument& arg) const;
-
-  template <int N>
-  int matchKeysImpl(cmExpandedCommandArgument const&);
-
-  template <int N, typename T, typename... Keys>
-  int matchKeysImpl(cmExpandedCommandArgument const&, T, Keys...);
-
-  template <typename... Keys>
-  int matchKeys(cmExpandedCommandArgument const&, Keys...);
-
-  bool HandleLevel0(cmArgumentList& newArgs, std::string& errorString,
-                    MessageType& status);
-
-  bool HandleLevel1(cmArgumentList& newArgs, std::string&, MessageType&);
-
-  bool HandleLevel2(cmArgumentList& newArgs, std::string& errorString,
-                    MessageType& status);
-
-  bool HandleLevel3(cmArgumentList& newArgs, std::string& errorString,
-                    MessageType& status);
-
-  bool HandleLevel4(cmArgumentList& newArgs, std::string& errorString,
-                    MessageType& status);
+  bool GetBooleanValue(cmExpandedCommandArgument const& arg) const;
 
   cmMakefile& Makefile;
   cmListFileBacktrace Backtrace;
@@ -2,11 +2,14 @@
    file LICENSE.rst or https://cmake.org/licensing for details.  */
 #include "cmCryptoHash.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 
 #include <cm/memory>
 
 #include <cm3p/kwiml/int.h>
+#include <cm3p/rapidhash.h>
 #include <cm3p/rhash.h>
 
 #include "cmsys/FStream.hxx"
@@ -22,7 +25,75 @@ static unsigned int const cmCryptoHashAlgoToId[] = {
   RHASH_SHA3_224, //
   RHASH_SHA3_256, //
   RHASH_SHA3_384, //
-  RHASH_SHA3_512
+  RHASH_SHA3_512, //
+  0               // RAPIDHASH is not provided by librhash
+};
+
+// RAPIDHASH is a tree hash: the input is split into blocks of this size,
+// each block is hashed independently, and the block hashes are hashed
+// together.  This keeps the state small for streaming input, and lets
+// block hashes be computed in any order.
+static std::size_t const cmCryptoHashRapidBlockSize = 1024 * 1024;
+
+struct cmCryptoHash::RapidHashState
+{
+  std::vector<unsigned char> Block;
+  std::vector<unsigned char> BlockHashes;
+  std::uint64_t Length = 0;
+
+  void Reset()
+  {
+    this->Block.clear();
+    this->BlockHashes.clear();
+    this->Length = 0;
+  }
+
+  void AppendBlockHash(void const* data, std::size_t size)
+  {
+    // Store block hashes in little-endian order for portable results.
+    std::uint64_t h = rapidhash(data, size);
+    for (int i = 0; i < 8; ++i) {
+      this->BlockHashes.push_back(static_cast<unsigned char>(h >> (8 * i)));
+    }
+  }
+
+  void Append(unsigned char const* data, std::size_t size)
+  {
+    this->Length += size;
+    while (size > 0) {
+      if (this->Block.empty() && size >= cmCryptoHashRapidBlockSize) {
+        // Hash whole blocks directly from the caller's buffer.
+        this->AppendBlockHash(data, cmCryptoHashRapidBlockSize);
+        data += cmCryptoHashRapidBlockSize;
+        size -= cmCryptoHashRapidBlockSize;
+        continue;
+      }
+      std::size_t n =
+        std::min(size, cmCryptoHashRapidBlockSize - this->Block.size());
+      this->Block.insert(this->Block.end(), data, data + n);
+      data += n;
+      size -= n;
+      if (this->Block.size() == cmCryptoHashRapidBlockSize) {
+        this->AppendBlockHash(this->Block.data(), this->Block.size());
+        this->Block.clear();
+      }
+    }
+  }
+
+  std::vector<unsigned char> Finalize()
+  {
+    if (!this->Block.empty() || this->Length == 0) {
+      this->AppendBlockHash(this->Block.data(), this->Block.size());
+    }
+    std::uint64_t h = rapidhash_withSeed(
+      this->BlockHashes.data(), this->BlockHashes.size(), this->Length);
+    this->Reset();
+    std::vector<unsigned char> hash(8);
+    for (int i = 0; i < 8; ++i) {
+      hash[7 - i] = static_cast<unsigned char>(h >> (8 * i));
+    }
+    return hash;
+  }
 };
 
 static int cmCryptoHash_rhash_library_initialized;
@@ -38,13 +109,20 @@ static rhash cmCryptoHash_rhash_init(unsigned int id)
 
 cmCryptoHash::cmCryptoHash(Algo algo)
   : Id(cmCryptoHashAlgoToId[algo])
-  , CTX(cmCryptoHash_rhash_init(this->Id))
+  , CTX(nullptr)
 {
+  if (algo == AlgoRAPIDHASH) {
+    this->Rapid = cm::make_unique<RapidHashState>();
+  } else {
+    this->CTX = cmCryptoHash_rhash_init(this->Id);
+  }
 }
 
 cmCryptoHash::~cmCryptoHash()
 {
-  rhash_free(this->CTX);
+  if (this->CTX) {
+    rhash_free(this->CTX);
+  }
 }
 
 std::unique_ptr<cmCryptoHash> cmCryptoHash::New(cm::string_view algo)
@@ -79,6 +157,9 @@ std::unique_ptr<cmCryptoHash> cmCryptoHash::New(cm::string_view algo)
   if (algo == "SHA3_512") {
     return cm::make_unique<cmCryptoHash>(AlgoSHA3_512);
   }
+  if (algo == "RAPIDHASH") {
+    return cm::make_unique<cmCryptoHash>(AlgoRAPIDHASH);
+  }
   return std::unique_ptr<cmCryptoHash>();
 }
 
@@ -87,6 +168,9 @@ std::string cmCryptoHash::GetHashAlgoName() const
 #ifndef CMAKE_USE_SYSTEM_LIBRHASH
   static_assert(RHASH_HASH_COUNT == 10, "Update switch statement!");
 #endif
+  if (this->Rapid) {
+    return "RAPIDHASH";
+  }
   switch (this->Id) {
     case RHASH_MD5:
       return "MD5";
@@ -113,6 +197,11 @@ std::string cmCryptoHash::GetHashAlgoName() const
   return "UNKNOWN";
 }
 
+bool cmCryptoHash::IsCryptographic() const
+{
+  return !this->Rapid;
+}
+
 bool cmCryptoHash::IntFromHexDigit(char input, char& output)
 {
   if (input >= '0' && input <= '9') {
@@ -158,18 +247,21 @@ std::vector<unsigned char> cmCryptoHash::ByteHashStream(std::istream& sin)
   if (sin) {
     this->Initialize();
     {
-      // Should be efficient enough on most system:
-      KWIML_INT_uint64_t buffer[512];
-      char* buffer_c = reinterpret_cast<char*>(buffer);
+      // Read in large blocks to keep the per-read overhead small
+      // relative to fast hash algorithms.
+      std::vector<KWIML_INT_uint64_t> buffer(8192);
+      char* buffer_c = reinterpret_cast<char*>(buffer.data());
       unsigned char const* buffer_uc =
-        reinterpret_cast<unsigned char const*>(buffer);
+        reinterpret_cast<unsigned char const*>(buffer.data());
+      std::streamsize const buffer_size =
+        static_cast<std::streamsize>(buffer.size() * sizeof(buffer[0]));
       // This copy loop is very sensitive on certain platforms with
       // slightly broken stream libraries (like HPUX).  Normally, it is
       // incorrect to not check the error condition on the fin.read()
       // before using the data, but the fin.gcount() will be zero if an
       // error occurred.  Therefore, the loop should be safe everywhere.
       while (sin) {
-        sin.read(buffer_c, sizeof(buffer));
+        sin.read(buffer_c, buffer_size);
         if (int gcount = static_cast<int>(sin.gcount())) {
           this->Append(buffer_uc, gcount);
         }
@@ -209,21 +301,32 @@ std::string cmCryptoHash::HashFile(std::string const& file)
 
 void cmCryptoHash::Initialize()
 {
+  if (this->Rapid) {
+    this->Rapid->Reset();
+    return;
+  }
   rhash_reset(this->CTX);
 }
 
 void cmCryptoHash::Append(void const* buf, size_t sz)
 {
+  if (this->Rapid) {
+    this->Rapid->Append(static_cast<unsigned char const*>(buf), sz);
+    return;
+  }
   rhash_update(this->CTX, buf, sz);
 }
 
 void cmCryptoHash::Append(cm::string_view input)
 {
-  rhash_update(this->CTX, input.data(), input.size());
+  this->Append(input.data(), input.size());
 }
 
 std::vector<unsigned char> cmCryptoHash::Finalize()
 {
+  if (this->Rapid) {
+    return this->Rapid->Finalize();
+  }
   std::vector<unsigned char> hash(rhash_get_digest_size(this->Id), 0);
   rhash_final(this->CTX, hash.data());
   return hash;
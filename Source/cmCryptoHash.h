@@ -29,7 +29,8 @@ public:
     AlgoSHA3_224,
     AlgoSHA3_256,
     AlgoSHA3_384,
-    AlgoSHA3_512
+    AlgoSHA3_512,
+    AlgoRAPIDHASH
   };
 
   cmCryptoHash(Algo algo);
@@ -41,7 +42,7 @@ public:
   /// @brief Returns a new hash generator of the requested type
   /// @arg algo Hash type name. Supported hash types are
   ///      MD5, SHA1, SHA224, SHA256, SHA384, SHA512,
-  ///      SHA3_224, SHA3_256, SHA3_384, SHA3_512
+  ///      SHA3_224, SHA3_256, SHA3_384, SHA3_512, RAPIDHASH
   /// @return A valid auto pointer if algo is supported or
   ///         an invalid/NULL pointer otherwise
   static std::unique_ptr<cmCryptoHash> New(cm::string_view algo);
@@ -91,6 +92,11 @@ public:
   /// @return The name of the hash type associated with this hash generator.
   std::string GetHashAlgoName() const;
 
+  /// @brief Returns whether the hash is meant to resist deliberate
+  ///        collisions.  Non-cryptographic hashes must not be used to
+  ///        verify content from untrusted sources.
+  bool IsCryptographic() const;
+
   void Initialize();
   void Append(void const*, size_t);
   void Append(cm::string_view input);
@@ -98,6 +104,9 @@ public:
   std::string FinalizeHex();
 
 private:
+  struct RapidHashState;
+
   unsigned int Id;
   struct rhash_context* CTX;
+  std::unique_ptr<RapidHashState> Rapid;
 };
@@ -37,7 +37,7 @@ cmValue cmDefinitions::Get(std::string const& key, StackIter begin,
                            StackIter end)
 {
   Def const& def = cmDefinitions::GetInternal(key, begin, end, false);
-  return def.Value ? cmValue(def.Value.str_if_stable()) : nullptr;
+  return def.Value ? cmValue(def.Value.get()) : nullptr;
 }
 
 void cmDefinitions::Raise(std::string const& key, StackIter begin,
@@ -102,6 +102,30 @@ void cmDefinitions::Set(std::string const& key, cm::string_view value)
   this->Map[key] = Def(value);
 }
 
+void cmDefinitions::Append(std::string const& key, cm::string_view value,
+                           cm::string_view separator, StackIter begin,
+                           StackIter end)
+{
+  // Localize the definition so that parent scopes are not modified.
+  cmDefinitions::Raise(key, begin, end);
+  std::shared_ptr<std::string>& str = begin->Map[key].Value;
+  if (!str) {
+    str = std::make_shared<std::string>(value);
+    return;
+  }
+  if (str.use_count() > 1) {
+    // Another scope shares the value.  Copy it before modifying.
+    auto copy = std::make_shared<std::string>();
+    copy->reserve(str->size() + separator.size() + value.size());
+    copy->assign(*str);
+    str = std::move(copy);
+  }
+  if (!str->empty()) {
+    str->append(separator.data(), separator.size());
+  }
+  str->append(value.data(), value.size());
+}
+
 void cmDefinitions::Unset(std::string const& key)
 {
   this->Map[key] = Def();
@@ -4,6 +4,7 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -43,6 +44,13 @@ public:
   /** Set a value associated with a key.  */
   void Set(std::string const& key, cm::string_view value);
 
+  /** Append to the value associated with a key in the scope 'begin',
+      inserting 'separator' first if the existing value is not empty.
+      Repeated appends take amortized constant time.  */
+  static void Append(std::string const& key, cm::string_view value,
+                     cm::string_view separator, StackIter begin,
+                     StackIter end);
+
   /** Unset a definition.  */
   void Unset(std::string const& key);
 
@@ -53,10 +61,12 @@ private:
   public:
     Def() = default;
     Def(cm::string_view value)
-      : Value(value)
+      : Value(std::make_shared<std::string>(value))
     {
     }
-    cm::String Value;
+    // Definitions copied between scopes share the string.  It is modified
+    // in place only by Append, and only while not shared.
+    std::shared_ptr<std::string> Value;
   };
   static Def NoDef;
 
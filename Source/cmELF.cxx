@@ -5,9 +5,11 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <sstream>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -115,6 +117,8 @@ public:
   virtual std::vector<char> EncodeDynamicEntries(
     cmELF::DynamicEntryList const&) = 0;
   virtual StringEntry const* GetDynamicSectionString(unsigned int tag) = 0;
+  virtual std::vector<std::string> GetDynamicSectionStringList(
+    unsigned int tag) = 0;
   virtual bool IsMips() const = 0;
   virtual void PrintInfo(std::ostream& os) const = 0;
 
@@ -139,6 +143,12 @@ public:
     return this->GetDynamicSectionString(DT_RUNPATH);
   }
 
+  // Lookup all NEEDED entries in the DYNAMIC section.
+  std::vector<std::string> GetNeeded()
+  {
+    return this->GetDynamicSectionStringList(DT_NEEDED);
+  }
+
   // Return the recorded ELF type.
   cmELF::FileType GetFileType() const { return this->ELFType; }
 
@@ -242,6 +252,10 @@ public:
   // Lookup a string from the dynamic section with the given tag.
   StringEntry const* GetDynamicSectionString(unsigned int tag) override;
 
+  // Lookup all strings from the dynamic section with the given tag.
+  std::vector<std::string> GetDynamicSectionStringList(
+    unsigned int tag) override;
+
   bool IsMips() const override { return this->ELFHeader.e_machine == EM_MIPS; }
 
   // Print information about the ELF file.
@@ -367,42 +381,101 @@ private:
     }
     return true;
   }
-  bool Read(ELF_Shdr& x)
+  // Read 'count' records spaced 'stride' bytes apart starting at file
+  // offset 'offset'.  The whole table is read with a single request
+  // instead of seeking to every record.
+  template <typename T>
+  bool ReadTable(unsigned long long offset, std::size_t stride, T* out,
+                 std::size_t count)
   {
-    if (this->Stream->read(reinterpret_cast<char*>(&x), sizeof(x)) &&
-        this->NeedSwap) {
-      this->ByteSwap(x);
+    if (count == 0) {
+      return true;
     }
-    return !this->Stream->fail();
-  }
-  bool Read(ELF_Dyn& x)
-  {
-    if (this->Stream->read(reinterpret_cast<char*>(&x), sizeof(x)) &&
-        this->NeedSwap) {
-      this->ByteSwap(x);
+    std::size_t const size = (count - 1) * stride + sizeof(T);
+    // Prevent OOM from malformed files.
+    if (stride > kMaxSectionSize || size > kMaxSectionSize) {
+      return false;
+    }
+    std::vector<char> buffer(size);
+    this->Stream->seekg(offset);
+    if (!this->Stream->read(buffer.data(), size)) {
+      return false;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      std::memcpy(&out[i], buffer.data() + i * stride, sizeof(T));
+      if (this->NeedSwap) {
+        this->ByteSwap(out[i]);
+      }
     }
-    return !this->Stream->fail();
+    return true;
   }
 
-  bool LoadSectionHeader(std::size_t i)
+  bool LoadSectionHeaders(std::size_t first, std::size_t count)
   {
-    // Read the section header from the file.
-    this->Stream->seekg(this->ELFHeader.e_shoff +
-                        this->ELFHeader.e_shentsize * i);
-    if (!this->Read(this->SectionHeaders[i])) {
+    // Read the section headers from the file.
+    if (!this->ReadTable(this->ELFHeader.e_shoff +
+                           this->ELFHeader.e_shentsize * first,
+                         this->ELFHeader.e_shentsize,
+                         this->SectionHeaders.data() + first, count)) {
       this->SetErrorMessage("Failed to load section headers.");
       return false;
     }
 
     // Identify some important sections.
-    if (this->SectionHeaders[i].sh_type == SHT_DYNAMIC) {
-      this->DynamicSectionIndex = static_cast<int>(i);
+    for (std::size_t i = first; i < first + count; ++i) {
+      if (this->SectionHeaders[i].sh_type == SHT_DYNAMIC) {
+        this->DynamicSectionIndex = static_cast<int>(i);
+      }
     }
     return true;
   }
 
   bool LoadDynamicSection();
 
+  // Get the string table referenced by the DYNAMIC section.
+  ELF_Shdr const* GetDynamicStringTable();
+
+  // Read the string at 'first' in the string table 'strtab'.  If
+  // 'padding' is true, also count the NULL terminators following it.
+  // The string is read in small blocks so that only the part of the
+  // table holding it is read.  Returns false if the string runs past
+  // the end of the file.
+  bool ReadDynamicString(ELF_Shdr const& strtab, unsigned long first,
+                         bool padding, std::string& value,
+                         unsigned long& last)
+  {
+    unsigned long const end = static_cast<unsigned long>(strtab.sh_size);
+    bool terminated = false;
+    last = first;
+    this->Stream->clear();
+    this->Stream->seekg(strtab.sh_offset + first);
+    char buffer[256];
+    while (last != end) {
+      std::size_t const n = static_cast<std::size_t>(
+        std::min<unsigned long>(sizeof(buffer), end - last));
+      this->Stream->read(buffer, static_cast<std::streamsize>(n));
+      std::size_t const count =
+        static_cast<std::size_t>(this->Stream->gcount());
+      for (std::size_t i = 0; i < count; ++i) {
+        char const c = buffer[i];
+        if ((c && terminated) || (!c && !padding)) {
+          return true;
+        }
+        ++last;
+        if (c) {
+          value += c;
+        } else {
+          terminated = true;
+        }
+      }
+      if (count < n) {
+        this->Stream->clear();
+        return false;
+      }
+    }
+    return true;
+  }
+
   // Store the main ELF header.
   ELF_Ehdr ELFHeader;
 
@@ -470,15 +543,13 @@ cmELFInternalImpl<Types>::cmELFInternalImpl(cmELF* external,
     return;
   }
   this->SectionHeaders.resize(std::max(numSections, minSections));
-  if (!this->LoadSectionHeader(0)) {
+  if (!this->LoadSectionHeaders(0, 1)) {
     return;
   }
   numSections = this->GetNumberOfSections();
   this->SectionHeaders.resize(std::max(numSections, minSections));
-  for (std::size_t i = 1; i < numSections; ++i) {
-    if (!this->LoadSectionHeader(i)) {
-      return;
-    }
+  if (numSections > 1 && !this->LoadSectionHeaders(1, numSections - 1)) {
+    return;
   }
 }
 
@@ -516,22 +587,35 @@ bool cmELFInternalImpl<Types>::LoadDynamicSection()
   }
   this->DynamicSectionEntries.resize(n);
 
-  // Read each entry.
-  for (std::size_t j = 0; j < n; ++j) {
-    // Seek to the beginning of the section entry.
-    this->Stream->seekg(sec.sh_offset + sec.sh_entsize * j);
-    ELF_Dyn& dyn = this->DynamicSectionEntries[j];
-
-    // Try reading the entry.
-    if (!this->Read(dyn)) {
-      this->SetErrorMessage("Error reading entry from DYNAMIC section.");
-      this->DynamicSectionIndex = -1;
-      return false;
-    }
+  // Read all entries.
+  if (!this->ReadTable(sec.sh_offset, sec.sh_entsize,
+                       this->DynamicSectionEntries.data(), n)) {
+    this->DynamicSectionEntries.clear();
+    this->SetErrorMessage("Error reading entry from DYNAMIC section.");
+    this->DynamicSectionIndex = -1;
+    return false;
   }
   return true;
 }
 
+template <class Types>
+typename cmELFInternalImpl<Types>::ELF_Shdr const*
+cmELFInternalImpl<Types>::GetDynamicStringTable()
+{
+  // Try reading the dynamic section.
+  if (!this->LoadDynamicSection()) {
+    return nullptr;
+  }
+
+  // Get the string table referenced by the DYNAMIC section.
+  ELF_Shdr const& sec = this->SectionHeaders[this->DynamicSectionIndex];
+  if (sec.sh_link >= this->SectionHeaders.size()) {
+    this->SetErrorMessage("Section DYNAMIC has invalid string table index.");
+    return nullptr;
+  }
+  return &this->SectionHeaders[sec.sh_link];
+}
+
 template <class Types>
 unsigned long cmELFInternalImpl<Types>::GetDynamicEntryPosition(int j)
 {
@@ -607,18 +691,12 @@ cmELF::StringEntry const* cmELFInternalImpl<Types>::GetDynamicSectionString(
   se.Size = 0;
   se.IndexInSection = -1;
 
-  // Try reading the dynamic section.
-  if (!this->LoadDynamicSection()) {
-    return nullptr;
-  }
-
   // Get the string table referenced by the DYNAMIC section.
-  ELF_Shdr const& sec = this->SectionHeaders[this->DynamicSectionIndex];
-  if (sec.sh_link >= this->SectionHeaders.size()) {
-    this->SetErrorMessage("Section DYNAMIC has invalid string table index.");
+  ELF_Shdr const* strtabPtr = this->GetDynamicStringTable();
+  if (!strtabPtr) {
     return nullptr;
   }
-  ELF_Shdr const& strtab = this->SectionHeaders[sec.sh_link];
+  ELF_Shdr const& strtab = *strtabPtr;
 
   // Look for the requested entry.
   for (auto di = this->DynamicSectionEntries.begin();
@@ -633,30 +711,16 @@ cmELF::StringEntry const* cmELFInternalImpl<Types>::GetDynamicSectionString(
         return nullptr;
       }
 
-      // Seek to the position reported by the entry.
-      unsigned long first = static_cast<unsigned long>(dyn.d_un.d_val);
-      unsigned long last = first;
-      unsigned long end = static_cast<unsigned long>(strtab.sh_size);
-      this->Stream->seekg(strtab.sh_offset + first);
-
       // Read the string.  It may be followed by more than one NULL
       // terminator.  Count the total size of the region allocated to
       // the string.  This assumes that the next string in the table
       // is non-empty, but the "chrpath" tool makes the same
       // assumption.
-      bool terminated = false;
-      char c;
-      while (last != end && this->Stream->get(c) && !(terminated && c)) {
-        ++last;
-        if (c) {
-          se.Value += c;
-        } else {
-          terminated = true;
-        }
-      }
+      unsigned long first = static_cast<unsigned long>(dyn.d_un.d_val);
+      unsigned long last = first;
 
       // Make sure the whole value was read.
-      if (!(*this->Stream)) {
+      if (!this->ReadDynamicString(strtab, first, true, se.Value, last)) {
         if (tag == cmELF::TagRPath) {
           this->SetErrorMessage(
             "Dynamic section specifies unreadable DT_RPATH");
@@ -685,6 +749,44 @@ cmELF::StringEntry const* cmELFInternalImpl<Types>::GetDynamicSectionString(
   return nullptr;
 }
 
+template <class Types>
+std::vector<std::string> cmELFInternalImpl<Types>::GetDynamicSectionStringList(
+  unsigned int tag)
+{
+  std::vector<std::string> result;
+
+  // Get the string table referenced by the DYNAMIC section.
+  ELF_Shdr const* strtabPtr = this->GetDynamicStringTable();
+  if (!strtabPtr) {
+    return result;
+  }
+  ELF_Shdr const& strtab = *strtabPtr;
+
+  // Read every entry with the requested tag.
+  for (ELF_Dyn const& dyn : this->DynamicSectionEntries) {
+    if (static_cast<tagtype>(dyn.d_tag) != static_cast<tagtype>(tag)) {
+      continue;
+    }
+    if (dyn.d_un.d_val >= strtab.sh_size) {
+      this->SetErrorMessage("Section DYNAMIC references string beyond "
+                            "the end of its string section.");
+      return std::vector<std::string>();
+    }
+
+    // Read up to the first NULL terminator.
+    std::string value;
+    unsigned long last;
+    if (!this->ReadDynamicString(
+          strtab, static_cast<unsigned long>(dyn.d_un.d_val), false, value,
+          last)) {
+      this->SetErrorMessage("Dynamic section specifies unreadable value");
+      return std::vector<std::string>();
+    }
+    result.push_back(std::move(value));
+  }
+  return result;
+}
+
 //============================================================================
 // External class implementation.
 
@@ -851,6 +953,16 @@ cmELF::StringEntry const* cmELF::GetRunPath()
   return nullptr;
 }
 
+std::vector<std::string> cmELF::GetNeeded()
+{
+  if (this->Valid() &&
+      (this->Internal->GetFileType() == cmELF::FileTypeExecutable ||
+       this->Internal->GetFileType() == cmELF::FileTypeSharedLibrary)) {
+    return this->Internal->GetNeeded();
+  }
+  return std::vector<std::string>();
+}
+
 bool cmELF::IsMIPS() const
 {
   if (this->Valid()) {
@@ -102,6 +102,9 @@ public:
   /** Get the RUNPATH field if any.  */
   StringEntry const* GetRunPath();
 
+  /** Get the NEEDED fields, in the order they appear.  */
+  std::vector<std::string> GetNeeded();
+
   /** Returns true if the ELF file targets a MIPS CPU.  */
   bool IsMIPS() const;
 
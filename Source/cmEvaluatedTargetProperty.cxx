@@ -32,9 +32,26 @@ EvaluatedTargetPropertyEntry EvaluateTargetPropertyEntry(
   if (entry.GetHadContextSensitiveCondition()) {
     ee.ContextDependent = true;
   }
+  if (entry.GetHadConfigSensitiveCondition()) {
+    ee.ConfigDependent = true;
+  }
   return ee;
 }
 
+bool EvaluatedTargetPropertyEntries::DependOnConfig() const
+{
+  if (this->HadContextSensitiveCondition ||
+      this->HadConfigSensitiveCondition) {
+    return true;
+  }
+  for (EvaluatedTargetPropertyEntry const& entry : this->Entries) {
+    if (entry.ContextDependent || entry.ConfigDependent) {
+      return true;
+    }
+  }
+  return false;
+}
+
 EvaluatedTargetPropertyEntries EvaluateTargetPropertyEntries(
   cmGeneratorTarget const* thisTarget, cm::GenEx::Context const& context,
   cmGeneratorExpressionDAGChecker* dagChecker,
@@ -70,6 +87,7 @@ void addInterfaceEntry(cmGeneratorTarget const* headTarget,
         lib.Target->EvaluateInterfaceProperty(prop, &eval, dagChecker, usage),
         ee.Values);
       ee.ContextDependent = eval.HadContextSensitiveCondition;
+      ee.ConfigDependent = eval.HadConfigSensitiveCondition;
       entries.Entries.emplace_back(std::move(ee));
     }
   }
@@ -95,6 +113,7 @@ void addInterfaceFileSetsEntry(cmGeneratorTarget const* headTarget,
           type, prop, &eval, dagChecker),
         ee.Values);
       ee.ContextDependent = eval.HadContextSensitiveCondition;
+      ee.ConfigDependent = eval.HadConfigSensitiveCondition;
       entries.Entries.emplace_back(std::move(ee));
     }
   }
@@ -114,6 +133,7 @@ void AddInterfaceEntries(cmGeneratorTarget const* headTarget,
           headTarget->GetLinkImplementation(context.Config, usage)) {
       entries.HadContextSensitiveCondition =
         impl->HadContextSensitiveCondition;
+      entries.HadConfigSensitiveCondition = impl->HadConfigSensitiveCondition;
 
       auto runtimeLibIt =
         impl->LanguageRuntimeLibraries.find(context.Language);
@@ -129,6 +149,7 @@ void AddInterfaceEntries(cmGeneratorTarget const* headTarget,
           headTarget->GetLinkImplementationLibraries(context.Config, usage)) {
       entries.HadContextSensitiveCondition =
         impl->HadContextSensitiveCondition;
+      entries.HadConfigSensitiveCondition = impl->HadConfigSensitiveCondition;
       addInterfaceEntry(headTarget, prop, context, dagChecker, entries, usage,
                         impl->Libraries);
     }
@@ -145,6 +166,7 @@ void AddInterfaceFileSetsEntries(cmGeneratorTarget const* headTarget,
         headTarget->GetLinkImplementationLibraries(
           context.Config, cmGeneratorTarget::UseTo::Compile)) {
     entries.HadContextSensitiveCondition = impl->HadContextSensitiveCondition;
+    entries.HadConfigSensitiveCondition = impl->HadConfigSensitiveCondition;
     addInterfaceFileSetsEntry(headTarget, type, prop, context, dagChecker,
                               entries, impl->Libraries);
   }
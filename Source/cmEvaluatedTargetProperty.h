@@ -41,6 +41,7 @@ struct EvaluatedTargetPropertyEntry
   cmListFileBacktrace Backtrace;
   std::vector<std::string> Values;
   bool ContextDependent = false;
+  bool ConfigDependent = false;
 };
 
 EvaluatedTargetPropertyEntry EvaluateTargetPropertyEntry(
@@ -51,6 +52,11 @@ struct EvaluatedTargetPropertyEntries
 {
   std::vector<EvaluatedTargetPropertyEntry> Entries;
   bool HadContextSensitiveCondition = false;
+  bool HadConfigSensitiveCondition = false;
+
+  // Whether evaluating the entries for another configuration could
+  // produce different values.
+  bool DependOnConfig() const;
 };
 
 EvaluatedTargetPropertyEntries EvaluateTargetPropertyEntries(
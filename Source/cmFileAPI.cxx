@@ -3,13 +3,16 @@
 #include "cmFileAPI.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cstddef>
 #include <ctime>
 #include <functional>
 #include <iomanip>
 #include <iterator>
 #include <sstream>
+#include <thread>
 #include <utility>
 
 #include <cm/optional>
@@ -45,6 +48,24 @@
 #  endif
 #endif
 
+namespace {
+std::unique_ptr<Json::StreamWriter> NewJsonWriter()
+{
+  Json::StreamWriterBuilder wbuilder;
+  wbuilder["indentation"] = "\t";
+  return std::unique_ptr<Json::StreamWriter>(wbuilder.newStreamWriter());
+}
+
+std::string WriteJsonString(Json::StreamWriter& writer,
+                            Json::Value const& value)
+{
+  std::ostringstream out;
+  writer.write(value, &out);
+  out << '\n';
+  return out.str();
+}
+}
+
 cmFileAPI::cmFileAPI(cmake* cm)
   : CMakeInstance(cm)
 {
@@ -56,10 +77,7 @@ cmFileAPI::cmFileAPI(cmake* cm)
     this->UserAPIv1 = cmStrCat(std::move(*cmakeConfigDir), "/api/v1"_s);
   }
 
-  Json::StreamWriterBuilder wbuilder;
-  wbuilder["indentation"] = "\t";
-  this->JsonWriter =
-    std::unique_ptr<Json::StreamWriter>(wbuilder.newStreamWriter());
+  this->JsonWriter = NewJsonWriter();
 }
 
 void cmFileAPI::ReadQueries()
@@ -199,23 +217,27 @@ std::string cmFileAPI::WriteJsonFile(
   Json::Value const& value, std::string const& prefix,
   std::string (*computeSuffix)(std::string const&))
 {
-  std::string fileName;
+  std::string fileName =
+    this->PlaceJsonFile(WriteJsonString(*this->JsonWriter, value), prefix,
+                        "tmp.json", computeSuffix);
 
-  // Write the json file with a temporary name.
-  std::string const& tmpFile = this->APIv1 + "/tmp.json";
-  cmsys::ofstream ftmp(tmpFile.c_str());
-  this->JsonWriter->write(value, &ftmp);
-  ftmp << "\n";
-  ftmp.close();
-  if (!ftmp) {
-    cmSystemTools::RemoveFile(tmpFile);
-    return fileName;
+  // Record this among files we have just written.
+  if (!fileName.empty()) {
+    this->ReplyFiles.insert(fileName);
   }
 
+  return fileName;
+}
+
+std::string cmFileAPI::PlaceJsonFile(
+  std::string const& content, std::string const& prefix,
+  std::string const& tmpName,
+  std::string (*computeSuffix)(std::string const&)) const
+{
   // Compute the final name for the file.
-  std::string suffix = computeSuffix(tmpFile);
+  std::string suffix = computeSuffix(content);
   std::string suffixWithExtension = cmStrCat('-', suffix, ".json");
-  fileName = cmStrCat(prefix, suffixWithExtension);
+  std::string fileName = cmStrCat(prefix, suffixWithExtension);
 
   // Truncate the file name length
   // eCryptFS has a maximal file name length recommendation of 140
@@ -236,21 +258,27 @@ std::string cmFileAPI::WriteJsonFile(
     fileName.replace(startPos, overLength, suffixWithExtension);
   }
 
-  // Create the destination.
-  std::string file = this->APIv1 + "/reply";
-  cmSystemTools::MakeDirectory(file);
-  file += "/";
-  file += fileName;
-
   // If the final name already exists then assume it has proper content.
-  // Otherwise, atomically place the reply file at its final name
-  if (cmSystemTools::FileExists(file, true) ||
-      !cmSystemTools::RenameFile(tmpFile, file)) {
-    cmSystemTools::RemoveFile(tmpFile);
+  std::string const replyDir = cmStrCat(this->APIv1, "/reply");
+  std::string const file = cmStrCat(replyDir, '/', fileName);
+  if (cmSystemTools::FileExists(file, true)) {
+    return fileName;
   }
 
-  // Record this among files we have just written.
-  this->ReplyFiles.insert(fileName);
+  // Otherwise, write the json file with a temporary name and atomically
+  // place it at its final name.
+  cmSystemTools::MakeDirectory(replyDir);
+  std::string const tmpFile = cmStrCat(this->APIv1, '/', tmpName);
+  cmsys::ofstream ftmp(tmpFile.c_str());
+  ftmp << content;
+  ftmp.close();
+  if (!ftmp) {
+    cmSystemTools::RemoveFile(tmpFile);
+    return std::string();
+  }
+  if (!cmSystemTools::RenameFile(tmpFile, file)) {
+    cmSystemTools::RemoveFile(tmpFile);
+  }
 
   return fileName;
 }
@@ -267,10 +295,58 @@ Json::Value cmFileAPI::MaybeJsonFile(Json::Value in, std::string const& prefix)
   return out;
 }
 
-std::string cmFileAPI::ComputeSuffixHash(std::string const& file)
+std::vector<Json::Value> cmFileAPI::MaybeJsonFiles(
+  std::vector<std::pair<Json::Value, std::string>> in)
+{
+  std::vector<Json::Value> out(in.size());
+  std::vector<std::string> fileNames(in.size());
+  std::vector<std::size_t> toWrite;
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    if (in[i].first.isObject() || in[i].first.isArray()) {
+      toWrite.push_back(i);
+    } else {
+      out[i] = std::move(in[i].first);
+    }
+  }
+
+  // Serialize, hash, and write the files on a few threads.  Each thread
+  // uses its own writer and temporary file.
+  std::atomic<std::size_t> next(0);
+  auto writeFiles = [this, &in, &fileNames, &toWrite,
+                     &next](std::string const& tmpName) {
+    std::unique_ptr<Json::StreamWriter> writer = NewJsonWriter();
+    for (std::size_t i = next++; i < toWrite.size(); i = next++) {
+      std::size_t const k = toWrite[i];
+      fileNames[k] =
+        this->PlaceJsonFile(WriteJsonString(*writer, in[k].first),
+                            in[k].second, tmpName, ComputeSuffixHash);
+    }
+  };
+  std::size_t const threadCount = std::min<std::size_t>(
+    toWrite.size(), std::max(std::thread::hardware_concurrency(), 1u));
+  std::vector<std::thread> threads;
+  for (std::size_t t = 1; t < threadCount; ++t) {
+    threads.emplace_back(writeFiles, cmStrCat("tmp-", t, ".json"));
+  }
+  writeFiles("tmp.json");
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (std::size_t k : toWrite) {
+    out[k] = Json::objectValue;
+    out[k]["jsonFile"] = fileNames[k];
+    if (!fileNames[k].empty()) {
+      this->ReplyFiles.insert(fileNames[k]);
+    }
+  }
+  return out;
+}
+
+std::string cmFileAPI::ComputeSuffixHash(std::string const& content)
 {
   cmCryptoHash hasher(cmCryptoHash::AlgoSHA3_256);
-  std::string hash = hasher.HashFile(file);
+  std::string hash = hasher.HashString(content);
   hash.resize(20, '0');
   return hash;
 }
@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <cm3p/json/value.h>
@@ -47,6 +48,11 @@ public:
       and holding the original object.  Other JSON types are unchanged.  */
   Json::Value MaybeJsonFile(Json::Value in, std::string const& prefix);
 
+  /** Convert many JSON values as MaybeJsonFile does, each paired with
+      its file name prefix.  The files are written concurrently.  */
+  std::vector<Json::Value> MaybeJsonFiles(
+    std::vector<std::pair<Json::Value, std::string>> in);
+
   /** Report file-api capabilities for cmake -E capabilities.  */
   static Json::Value ReportCapabilities();
 
@@ -220,6 +226,10 @@ private:
   std::string WriteJsonFile(
     Json::Value const& value, std::string const& prefix,
     std::string (*computeSuffix)(std::string const&) = ComputeSuffixHash);
+  std::string PlaceJsonFile(
+    std::string const& content, std::string const& prefix,
+    std::string const& tmpName,
+    std::string (*computeSuffix)(std::string const&)) const;
   static std::string ComputeSuffixHash(std::string const&);
   static std::string ComputeSuffixTime(std::string const&);
 
@@ -69,6 +69,9 @@ namespace {
 using TargetIndexMapType =
   std::unordered_map<cmGeneratorTarget const*, Json::ArrayIndex>;
 
+// Number of target objects dumped before their reply files are written.
+std::ptrdiff_t const TargetBatchSize = 256;
+
 std::string RelativeIfUnder(std::string const& top, std::string const& in)
 {
   return cmSystemTools::RelativeIfUnder(top, in);
@@ -292,7 +295,9 @@ class CodemodelConfig
   Json::ArrayIndex AddProject(cmStateSnapshot s);
 
   DumpedTargets DumpTargets();
-  Json::Value DumpTarget(cmGeneratorTarget* gt, Json::ArrayIndex ti);
+  std::string TargetPrefix(cmGeneratorTarget const* gt) const;
+  Json::Value DumpTarget(cmGeneratorTarget* gt, Json::Value target,
+                         Json::ArrayIndex ti);
 
   Json::Value DumpDirectories();
   Json::Value DumpDirectory(Directory& d);
@@ -727,36 +732,60 @@ CodemodelConfig::DumpedTargets CodemodelConfig::DumpTargets()
               return l->GetName() < r->GetName();
             });
 
-  for (cmGeneratorTarget* gt : targetList) {
-    if (gt->GetType() == cm::TargetType::GLOBAL_TARGET) {
-      continue;
-    }
-
-    // Ignore targets starting with `__cmake_` as they are internal.
-    if (cmHasLiteralPrefix(gt->GetName(), "__cmake_")) {
-      continue;
-    }
-
-    Json::Value& targets = gt->IsInBuildSystem()
-      ? dumpedTargets.BuildSystemTargets
-      : dumpedTargets.AbstractTargets;
-    targets.append(this->DumpTarget(gt, targets.size()));
+  targetList.erase(
+    std::remove_if(targetList.begin(), targetList.end(),
+                   [](cmGeneratorTarget const* gt) {
+                     // Ignore targets starting with `__cmake_` as they are
+                     // internal.
+                     return gt->GetType() == cm::TargetType::GLOBAL_TARGET ||
+                       cmHasLiteralPrefix(gt->GetName(), "__cmake_");
+                   }),
+    targetList.end());
+
+  // Target objects must be dumped on this thread, but their reply files
+  // can be written concurrently.  Work in batches to bound the number of
+  // dumped objects held in memory at once.
+  for (auto batch = targetList.begin(); batch != targetList.end();) {
+    auto const batchEnd = batch +
+      std::min<std::ptrdiff_t>(TargetBatchSize, targetList.end() - batch);
+    std::vector<std::pair<Json::Value, std::string>> objects;
+    objects.reserve(static_cast<std::size_t>(batchEnd - batch));
+    for (auto i = batch; i != batchEnd; ++i) {
+      Target t(*i, this->VersionMajor, this->VersionMinor, this->Config);
+      objects.emplace_back(t.Dump(), this->TargetPrefix(*i));
+    }
+    std::vector<Json::Value> files =
+      this->FileAPI.MaybeJsonFiles(std::move(objects));
+    for (auto i = batch; i != batchEnd; ++i) {
+      cmGeneratorTarget* gt = *i;
+      Json::Value& targets = gt->IsInBuildSystem()
+        ? dumpedTargets.BuildSystemTargets
+        : dumpedTargets.AbstractTargets;
+      targets.append(this->DumpTarget(
+        gt, std::move(files[static_cast<std::size_t>(i - batch)]),
+        targets.size()));
+    }
+    batch = batchEnd;
   }
 
   return dumpedTargets;
 }
 
-Json::Value CodemodelConfig::DumpTarget(cmGeneratorTarget* gt,
-                                        Json::ArrayIndex ti)
+std::string CodemodelConfig::TargetPrefix(cmGeneratorTarget const* gt) const
 {
-  Target t(gt, this->VersionMajor, this->VersionMinor, this->Config);
   std::string safeTargetName = gt->GetName();
   std::replace(safeTargetName.begin(), safeTargetName.end(), ':', '_');
   std::string prefix = "target-" + safeTargetName;
   if (!this->Config.empty()) {
     prefix += "-" + this->Config;
   }
-  Json::Value target = this->FileAPI.MaybeJsonFile(t.Dump(), prefix);
+  return prefix;
+}
+
+Json::Value CodemodelConfig::DumpTarget(cmGeneratorTarget* gt,
+                                        Json::Value target,
+                                        Json::ArrayIndex ti)
+{
   target["name"] = gt->GetName();
   target["id"] = TargetId(gt, this->TopBuild);
 
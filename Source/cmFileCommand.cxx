@@ -1705,6 +1705,68 @@ std::string CurlCompatFileURL(std::string url)
   return url;
 }
 
+// Get the path of the download cache entry holding content with the given
+// hash, or an empty string if no download cache is configured.
+std::string GetDownloadCacheEntry(cmMakefile const& mf,
+                                  cmCryptoHash const& hash,
+                                  std::string const& expectedHash)
+{
+  std::string dir;
+  if (cmValue v = mf.GetDefinition("CMAKE_DOWNLOAD_CACHE")) {
+    dir = *v;
+  } else if (cm::optional<std::string> e =
+               cmSystemTools::GetEnvVar("CMAKE_DOWNLOAD_CACHE")) {
+    dir = std::move(*e);
+  }
+  if (dir.empty()) {
+    return std::string();
+  }
+  // The hash names the entry, so it must not contain anything else.
+  if (expectedHash.empty() ||
+      expectedHash.find_first_not_of("0123456789abcdef") !=
+        std::string::npos) {
+    return std::string();
+  }
+  dir = cmSystemTools::CollapseFullPath(dir, mf.GetCurrentBinaryDirectory());
+  return cmStrCat(dir, '/', hash.GetHashAlgoName(), '/', expectedHash);
+}
+
+// Create 'file' from a download cache entry, sharing its content with
+// a reflink if the filesystem supports it.  Never hard link the entry:
+// modifying the file in place would then corrupt the cache.
+bool FetchFromDownloadCache(std::string const& entry, std::string const& file)
+{
+  cmSystemTools::RemoveFile(file);
+  if (cmsys::SystemTools::CloneFileContent(entry, file)) {
+    return true;
+  }
+  return cmSystemTools::CopySingleFile(
+           entry, file, cmSystemTools::CopyWhen::Unconditional,
+           cmSystemTools::CopyInputRecent::No) ==
+    cmSystemTools::CopyResult::Success;
+}
+
+// Add a verified download to the download cache.  The cache is only an
+// optimization, so failures are ignored.
+void StoreInDownloadCache(std::string const& file, std::string const& entry)
+{
+  if (cmSystemTools::FileExists(entry, true) ||
+      !cmSystemTools::MakeDirectory(cmSystemTools::GetFilenamePath(entry))) {
+    return;
+  }
+  // Populate a temporary file next to the entry and move it into place
+  // so that concurrent users never observe a partial entry.
+  std::string const tmp =
+    cmStrCat(entry, ".tmp", cmSystemTools::RandomNumber());
+  if (cmSystemTools::CopySingleFile(file, tmp,
+                                    cmSystemTools::CopyWhen::Unconditional,
+                                    cmSystemTools::CopyInputRecent::No) !=
+        cmSystemTools::CopyResult::Success ||
+      !cmSystemTools::RenameFile(tmp, entry)) {
+    cmSystemTools::RemoveFile(tmp);
+  }
+}
+
 size_t cmWriteToFileCallback(void* ptr, size_t size, size_t nmemb, void* data)
 {
   int realsize = static_cast<int>(size * nmemb);
@@ -2016,6 +2078,11 @@ bool HandleDownloadCommand(std::vector<std::string> const& args,
         status.SetError(err);
         return false;
       }
+      if (!hash->IsCryptographic()) {
+        status.SetError(cmStrCat("DOWNLOAD EXPECTED_HASH given ALGO ", algo,
+                                 " which is not a cryptographic hash."));
+        return false;
+      }
       hashMatchMSG = algo + " hash";
     } else if (*i == "USERPWD") {
       ++i;
@@ -2103,6 +2170,11 @@ bool HandleDownloadCommand(std::vector<std::string> const& args,
     status.SetError("DOWNLOAD cannot calculate hash if file is not saved.");
     return false;
   }
+  std::string cacheEntry;
+  if (!file.empty() && hash) {
+    cacheEntry =
+      GetDownloadCacheEntry(status.GetMakefile(), *hash, expectedHash);
+  }
   // If file exists already, and caller specified an expected md5 or sha,
   // and the existing file already has the expected hash, then simply
   // return.
@@ -2111,6 +2183,10 @@ bool HandleDownloadCommand(std::vector<std::string> const& args,
     std::string msg;
     std::string actualHash = hash->HashFile(file);
     if (actualHash == expectedHash) {
+      // Share the verified file with other builds using the cache.
+      if (!cacheEntry.empty()) {
+        StoreInDownloadCache(file, cacheEntry);
+      }
       msg = cmStrCat("skipping download as file already exists with expected ",
                      hashMatchMSG, '"');
       if (!statusVar.empty()) {
@@ -2119,6 +2195,27 @@ bool HandleDownloadCommand(std::vector<std::string> const& args,
       return true;
     }
   }
+  // If a download cache is configured and holds content with the
+  // expected hash, use it instead of downloading the file again.
+  if (!cacheEntry.empty() && cmSystemTools::FileExists(cacheEntry, true)) {
+    if (hash->HashFile(cacheEntry) != expectedHash) {
+      // The entry is corrupt.  Replace it with a fresh download.
+      cmSystemTools::RemoveFile(cacheEntry);
+    } else {
+      std::string dir = cmSystemTools::GetFilenamePath(file);
+      if ((dir.empty() || cmSystemTools::MakeDirectory(dir)) &&
+          FetchFromDownloadCache(cacheEntry, file)) {
+        std::string msg = cmStrCat(
+          "skipping download as download cache has file with expected ",
+          hashMatchMSG, '"');
+        if (!statusVar.empty()) {
+          status.GetMakefile().AddDefinition(statusVar,
+                                             cmStrCat(0, ";\"", msg));
+        }
+        return true;
+      }
+    }
+  }
   // Make sure parent directory exists so we can write to the file
   // as we receive downloaded bits from curl...
   //
@@ -2375,6 +2472,10 @@ bool HandleDownloadCommand(std::vector<std::string> const& args,
                                actualHash, "\"\n"));
       return false;
     }
+
+    if (!cacheEntry.empty()) {
+      StoreInDownloadCache(file, cacheEntry);
+    }
   }
 
   return true;
@@ -4169,6 +4270,7 @@ bool cmFileCommand(std::vector<std::string> const& args,
     { "SHA3_256"_s, HandleHashCommand },
     { "SHA3_384"_s, HandleHashCommand },
     { "SHA3_512"_s, HandleHashCommand },
+    { "RAPIDHASH"_s, HandleHashCommand },
     { "STRINGS"_s, HandleStringsCommand },
     { "GLOB"_s, HandleGlobCommand },
     { "GLOB_RECURSE"_s, HandleGlobRecurseCommand },
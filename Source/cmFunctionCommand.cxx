@@ -3,6 +3,7 @@
 #include "cmFunctionCommand.h"
 
 #include <functional>
+#include <memory>
 #include <utility>
 
 #include <cm/memory>
@@ -47,12 +48,18 @@ public:
   bool operator()(std::vector<cmListFileArgument> const& args,
                   cmExecutionStatus& inStatus) const;
 
-  std::vector<std::string> Args;
-  std::vector<cmListFileFunction> Functions;
-  cmPolicies::PolicyMap Policies;
-  cmDiagnostics::DiagnosticMap Diagnostics;
-  std::string FilePath;
-  long Line;
+  // The command is copied each time it is invoked, so the recorded
+  // definition is shared between all copies and executed in place.
+  struct Definition
+  {
+    std::vector<std::string> Args;
+    std::vector<cmListFileFunction> Functions;
+    cmPolicies::PolicyMap Policies;
+    cmDiagnostics::DiagnosticMap Diagnostics;
+    std::string FilePath;
+    long Line;
+  };
+  std::shared_ptr<Definition const> Def;
 };
 
 bool cmFunctionHelperCommand::operator()(
@@ -60,6 +67,7 @@ bool cmFunctionHelperCommand::operator()(
   cmExecutionStatus& inStatus) const
 {
   cmMakefile& makefile = inStatus.GetMakefile();
+  Definition const& def = *this->Def;
 
   // Expand the argument list to the function.
   std::vector<std::string> expandedArgs;
@@ -67,16 +75,16 @@ bool cmFunctionHelperCommand::operator()(
 
   // make sure the number of arguments passed is at least the number
   // required by the signature
-  if (expandedArgs.size() < this->Args.size() - 1) {
+  if (expandedArgs.size() < def.Args.size() - 1) {
     auto const errorMsg = cmStrCat(
       "Function invoked with incorrect arguments for function named: ",
-      this->Args.front());
+      def.Args.front());
     inStatus.SetError(errorMsg);
     return false;
   }
 
-  cmMakefile::FunctionPushPop functionScope(&makefile, this->FilePath,
-                                            this->Policies, this->Diagnostics);
+  cmMakefile::FunctionPushPop functionScope(&makefile, def.FilePath,
+                                            def.Policies, def.Diagnostics);
 
   // set the value of argc
   makefile.AddDefinition(ARGC, std::to_string(expandedArgs.size()));
@@ -90,17 +98,17 @@ bool cmFunctionHelperCommand::operator()(
   }
 
   // define the formal arguments
-  for (auto j = 1u; j < this->Args.size(); ++j) {
-    makefile.AddDefinition(this->Args[j], expandedArgs[j - 1]);
+  for (auto j = 1u; j < def.Args.size(); ++j) {
+    makefile.AddDefinition(def.Args[j], expandedArgs[j - 1]);
   }
 
   // define ARGV, ARGN, and ARGNC
   auto const argvDef = cmList::to_string(expandedArgs);
-  auto const expIt = expandedArgs.begin() + (this->Args.size() - 1);
+  auto const expIt = expandedArgs.begin() + (def.Args.size() - 1);
   auto const argnDef =
     cmList::to_string(cmMakeRange(expIt, expandedArgs.end()));
   auto const functionArgncDef =
-    std::to_string(expandedArgs.size() - (this->Args.size() - 1));
+    std::to_string(expandedArgs.size() - (def.Args.size() - 1));
   makefile.AddDefinition(ARGV, argvDef);
   makefile.MarkVariableAsUsed(ARGV);
   makefile.AddDefinition(ARGN, argnDef);
@@ -108,20 +116,20 @@ bool cmFunctionHelperCommand::operator()(
   makefile.AddDefinition(ARGNC, functionArgncDef);
   makefile.MarkVariableAsUsed(ARGNC);
 
-  makefile.AddDefinition(CMAKE_CURRENT_FUNCTION, this->Args.front());
+  makefile.AddDefinition(CMAKE_CURRENT_FUNCTION, def.Args.front());
   makefile.MarkVariableAsUsed(CMAKE_CURRENT_FUNCTION);
-  makefile.AddDefinition(CMAKE_CURRENT_FUNCTION_LIST_FILE, this->FilePath);
+  makefile.AddDefinition(CMAKE_CURRENT_FUNCTION_LIST_FILE, def.FilePath);
   makefile.MarkVariableAsUsed(CMAKE_CURRENT_FUNCTION_LIST_FILE);
   makefile.AddDefinition(CMAKE_CURRENT_FUNCTION_LIST_DIR,
-                         cmSystemTools::GetFilenamePath(this->FilePath));
+                         cmSystemTools::GetFilenamePath(def.FilePath));
   makefile.MarkVariableAsUsed(CMAKE_CURRENT_FUNCTION_LIST_DIR);
   makefile.AddDefinition(CMAKE_CURRENT_FUNCTION_LIST_LINE,
-                         std::to_string(this->Line));
+                         std::to_string(def.Line));
   makefile.MarkVariableAsUsed(CMAKE_CURRENT_FUNCTION_LIST_LINE);
 
   // Invoke all the functions that were collected in the block.
   // for each function
-  for (cmListFileFunction const& func : this->Functions) {
+  for (cmListFileFunction const& func : def.Functions) {
     cmExecutionStatus status(makefile);
     if (!makefile.ExecuteCommand(func, status) || status.GetNestedError()) {
       // The error message should have already included the call stack
@@ -173,13 +181,15 @@ bool cmFunctionFunctionBlocker::Replay(
 {
   cmMakefile& mf = status.GetMakefile();
   // create a new command and add it to cmake
+  auto def = std::make_shared<cmFunctionHelperCommand::Definition>();
+  def->Args = this->Args;
+  def->Functions = std::move(functions);
+  def->FilePath = this->GetStartingContext().FilePath;
+  def->Line = this->GetStartingContext().Line;
+  mf.RecordPolicies(def->Policies);
+  mf.RecordDiagnostics(def->Diagnostics);
   cmFunctionHelperCommand f;
-  f.Args = this->Args;
-  f.Functions = std::move(functions);
-  f.FilePath = this->GetStartingContext().FilePath;
-  f.Line = this->GetStartingContext().Line;
-  mf.RecordPolicies(f.Policies);
-  mf.RecordDiagnostics(f.Diagnostics);
+  f.Def = std::move(def);
   return mf.GetState()->AddScriptedCommand(
     this->Args.front(), cmStateEnums::CommandType::Function,
     BT<cmState::Command>(std::move(f),
@@ -37,6 +37,7 @@ struct Evaluation final
   bool Quiet;
   bool HadError = false;
   bool HadContextSensitiveCondition = false;
+  bool HadConfigSensitiveCondition = false;
   bool HadHeadSensitiveCondition = false;
   bool HadLinkLanguageSensitiveCondition = false;
   bool EvaluateForBuildsystem;
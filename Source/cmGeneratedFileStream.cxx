@@ -2,7 +2,11 @@
    file LICENSE.rst or https://cmake.org/licensing for details.  */
 #include "cmGeneratedFileStream.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
+#include <cstring>
+#include <cwchar>
 #include <locale>
 
 #include "cmStringAlgorithms.h"
@@ -14,8 +18,19 @@
 #  include "cm_codecvt.hxx"
 #endif
 
+namespace {
+std::atomic<std::size_t> TotalWritten(0);
+std::atomic<std::size_t> TotalUnchanged(0);
+std::atomic<unsigned long long> TotalUnchangedBytes(0);
+
+// Copy-if-different output larger than this is streamed to the
+// temporary file instead of being held in memory.
+std::size_t const MaxMemoryContent = 16 << 20;
+}
+
 cmGeneratedFileStream::cmGeneratedFileStream(Encoding encoding)
 {
+  this->Encoded = encoding != codecvt_Encoding::None;
 #ifndef CMAKE_BOOTSTRAP
   if (encoding != codecvt_Encoding::None) {
     this->imbue(std::locale(this->getloc(), new codecvt(encoding)));
@@ -35,6 +50,7 @@ cmGeneratedFileStream::cmGeneratedFileStream(std::string const& name,
     cmSystemTools::Error("Cannot open file for write: " + this->TempName);
     cmSystemTools::ReportLastSystemError("");
   }
+  this->Encoded = encoding != codecvt_Encoding::None;
 #ifndef CMAKE_BOOTSTRAP
   if (encoding != codecvt_Encoding::None) {
     this->imbue(std::locale(this->getloc(), new codecvt(encoding)));
@@ -65,6 +81,7 @@ cmGeneratedFileStream& cmGeneratedFileStream::Open(std::string const& name,
 {
   // Store the file name and construct the temporary file name.
   this->cmGeneratedFileStreamBase::Open(name);
+  this->Binary = binaryFlag;
 
   // Open the temporary output file.
   if (binaryFlag) {
@@ -80,6 +97,9 @@ cmGeneratedFileStream& cmGeneratedFileStream::Open(std::string const& name,
     cmSystemTools::Error("Cannot open file for write: " + this->TempName);
     cmSystemTools::ReportLastSystemError("");
   }
+  if (this->CopyIfDifferent) {
+    this->UseMemoryBuffer();
+  }
   return *this;
 }
 
@@ -88,7 +108,15 @@ bool cmGeneratedFileStream::Close()
   // Save whether the temporary output file is valid before closing.
   this->Okay = !this->fail();
 
-  // Close the temporary output file.
+  // Close the temporary output file.  Output collected in memory is
+  // written to it later, so restore the file buffer first.  Output that
+  // outgrew the memory buffer is already in the file.
+  if (this->InMemory) {
+    this->std::ios::rdbuf(this->Stream::rdbuf());
+    if (this->Memory.Spilled) {
+      this->InMemory = false;
+    }
+  }
   this->Stream::close(); // NOLINT(cmake-use-cmsys-fstream)
 
   // Remove the temporary file (possibly by renaming to the real file).
@@ -98,6 +126,25 @@ bool cmGeneratedFileStream::Close()
 void cmGeneratedFileStream::SetCopyIfDifferent(bool copy_if_different)
 {
   this->CopyIfDifferent = copy_if_different;
+  if (copy_if_different) {
+    this->UseMemoryBuffer();
+  }
+}
+
+void cmGeneratedFileStream::UseMemoryBuffer()
+{
+  // The memory buffer does not convert encodings, and switching is only
+  // possible before anything has been written to the temporary file.
+  // Leave the file open so that closing the stream still succeeds.
+  if (this->InMemory || this->Encoded || this->Compress || !*this ||
+      !this->Stream::is_open() || this->tellp() != 0) {
+    return;
+  }
+  this->Memory.Content.clear();
+  this->Memory.File = this->Stream::rdbuf();
+  this->Memory.Spilled = false;
+  this->std::ios::rdbuf(&this->Memory);
+  this->InMemory = true;
 }
 
 void cmGeneratedFileStream::SetCompression(bool compression)
@@ -159,24 +206,53 @@ bool cmGeneratedFileStreamBase::Close()
     resname += ".gz";
   }
 
+  // Output collected in memory is compared with the destination file
+  // directly, and written to the temporary file only if it differs.
+  bool compared = false;
+  if (this->InMemory) {
+    this->InMemory = false;
+    std::string content;
+    content.swap(this->Memory.Content);
+    bool write = !this->Name.empty() && this->Okay;
+    if (write && !this->Compress) {
+      if (!this->ContentDiffers(content, resname)) {
+        ++TotalUnchanged;
+        TotalUnchangedBytes += content.size();
+        write = false;
+      }
+      compared = true;
+    }
+    if (!write || !this->WriteTempFile(content)) {
+      cmSystemTools::RemoveFile(this->TempName);
+      return false;
+    }
+  }
+
   // Only consider replacing the destination file if no error
   // occurred.
   if (!this->Name.empty() && this->Okay &&
-      (!this->CopyIfDifferent ||
+      (!this->CopyIfDifferent || compared ||
        cmSystemTools::FilesDiffer(this->TempName, resname))) {
     // The destination is to be replaced.  Rename the temporary to the
     // destination atomically.
+    bool renamed = false;
     if (this->Compress) {
       std::string gzname = cmStrCat(this->TempName, ".temp.gz");
       if (this->CompressFile(this->TempName, gzname)) {
-        this->RenameFile(gzname, resname);
+        renamed = this->RenameFile(gzname, resname) != 0;
       }
       cmSystemTools::RemoveFile(gzname);
     } else {
-      this->RenameFile(this->TempName, resname);
+      renamed = this->RenameFile(this->TempName, resname) != 0;
     }
 
     replaced = true;
+    if (renamed && this->CopyIfDifferent) {
+      ++TotalWritten;
+    }
+  } else if (!this->Name.empty() && this->Okay) {
+    ++TotalUnchanged;
+    TotalUnchangedBytes += cmSystemTools::FileLength(this->TempName);
   }
 
   // Else, the destination was not replaced.
@@ -189,6 +265,115 @@ bool cmGeneratedFileStreamBase::Close()
   return replaced;
 }
 
+bool cmGeneratedFileStreamBase::ContentDiffers(
+  std::string const& content, std::string const& resname) const
+{
+  std::string translated;
+  std::string const* expected = &content;
+#if defined(_WIN32)
+  // Compare with what a text mode stream would write.
+  if (!this->Binary) {
+    translated.reserve(content.size() + content.size() / 32);
+    for (char c : content) {
+      if (c == '\n') {
+        translated += '\r';
+      }
+      translated += c;
+    }
+    expected = &translated;
+  }
+#endif
+
+  if (!cmSystemTools::FileExists(resname, true) ||
+      cmSystemTools::FileLength(resname) != expected->size()) {
+    return true;
+  }
+  cmsys::ifstream fin(resname.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    return true;
+  }
+  char buffer[16384];
+  std::size_t offset = 0;
+  while (offset < expected->size()) {
+    std::size_t const n = std::min(sizeof(buffer), expected->size() - offset);
+    if (!fin.read(buffer, static_cast<std::streamsize>(n)) ||
+        std::memcmp(buffer, expected->data() + offset, n) != 0) {
+      return true;
+    }
+    offset += n;
+  }
+  return false;
+}
+
+bool cmGeneratedFileStreamBase::WriteTempFile(std::string const& content)
+{
+  cmsys::ofstream fout(this->TempName.c_str(),
+                       this->Binary ? std::ios::out | std::ios::binary
+                                    : std::ios::out);
+  fout.write(content.data(), static_cast<std::streamsize>(content.size()));
+  fout.close();
+  return !fout.fail();
+}
+
+bool cmGeneratedFileStreamBase::MemoryBuffer::Reserve(std::size_t n)
+{
+  if (this->Spilled || this->Content.size() + n <= MaxMemoryContent) {
+    return true;
+  }
+  // Move the collected output to the temporary file.
+  std::streamsize const size =
+    static_cast<std::streamsize>(this->Content.size());
+  if (this->File->sputn(this->Content.data(), size) != size) {
+    return false;
+  }
+  std::string().swap(this->Content);
+  this->Spilled = true;
+  return true;
+}
+
+cmGeneratedFileStreamBase::MemoryBuffer::int_type
+cmGeneratedFileStreamBase::MemoryBuffer::overflow(int_type c)
+{
+  if (traits_type::eq_int_type(c, traits_type::eof())) {
+    return traits_type::not_eof(c);
+  }
+  if (!this->Reserve(1)) {
+    return traits_type::eof();
+  }
+  if (this->Spilled) {
+    return this->File->sputc(traits_type::to_char_type(c));
+  }
+  this->Content += traits_type::to_char_type(c);
+  return c;
+}
+
+std::streamsize cmGeneratedFileStreamBase::MemoryBuffer::xsputn(
+  char const* s, std::streamsize n)
+{
+  if (!this->Reserve(static_cast<std::size_t>(n))) {
+    return 0;
+  }
+  if (this->Spilled) {
+    return this->File->sputn(s, n);
+  }
+  this->Content.append(s, static_cast<std::string::size_type>(n));
+  return n;
+}
+
+cmGeneratedFileStreamBase::MemoryBuffer::pos_type
+cmGeneratedFileStreamBase::MemoryBuffer::seekoff(
+  off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+  if (this->Spilled) {
+    return this->File->pubseekoff(off, dir, which);
+  }
+  // Only report the current position, as tellp() does.
+  if (off == 0 && dir == std::ios_base::cur && (which & std::ios_base::out)) {
+    return pos_type(static_cast<off_type>(this->Content.size()));
+  }
+  return pos_type(off_type(-1));
+}
+
 #ifndef CMAKE_BOOTSTRAP
 int cmGeneratedFileStreamBase::CompressFile(std::string const& oldname,
                                             std::string const& newname)
@@ -244,6 +429,34 @@ void cmGeneratedFileStream::WriteAltEncoding(std::string const& data,
                                              Encoding encoding)
 {
 #ifndef CMAKE_BOOTSTRAP
+  if (this->InMemory) {
+    // The memory buffer does not convert, so convert the data here.
+    std::locale const loc(this->getloc(), new codecvt(encoding));
+    auto const& cvt =
+      std::use_facet<std::codecvt<char, char, std::mbstate_t>>(loc);
+    if (cvt.always_noconv()) {
+      this->write(data.data(), data.size());
+      return;
+    }
+    std::mbstate_t state = std::mbstate_t();
+    char const* from = data.data();
+    char const* const fromEnd = from + data.size();
+    char buffer[1024];
+    char* to;
+    for (;;) {
+      char const* fromNext;
+      auto const result = cvt.out(state, from, fromEnd, fromNext, buffer,
+                                  buffer + sizeof(buffer), to);
+      this->write(buffer, to - buffer);
+      from = fromNext;
+      if (result != std::codecvt_base::partial || from == fromEnd) {
+        break;
+      }
+    }
+    cvt.unshift(state, buffer, buffer + sizeof(buffer), to);
+    this->write(buffer, to - buffer);
+    return;
+  }
   std::locale prevLocale =
     this->imbue(std::locale(this->getloc(), new codecvt(encoding)));
   this->write(data.data(), data.size());
@@ -253,3 +466,12 @@ void cmGeneratedFileStream::WriteAltEncoding(std::string const& data,
   this->write(data.data(), data.size());
 #endif
 }
+
+cmGeneratedFileStream::Statistics cmGeneratedFileStream::GetStatistics()
+{
+  Statistics stats;
+  stats.Written = TotalWritten;
+  stats.Unchanged = TotalUnchanged;
+  stats.UnchangedBytes = TotalUnchangedBytes;
+  return stats;
+}
@@ -4,6 +4,9 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
+#include <ios>
+#include <streambuf>
 #include <string>
 
 #include "cmsys/FStream.hxx"
@@ -39,6 +42,45 @@ protected:
   // Internal file compression implementation.
   int CompressFile(std::string const& oldname, std::string const& newname);
 
+  // Internal methods to handle output collected in memory.
+  bool ContentDiffers(std::string const& content,
+                      std::string const& resname) const;
+  bool WriteTempFile(std::string const& content);
+
+  // Collects the output of a copy-if-different stream instead of the
+  // temporary file, so that a file whose content did not change is
+  // only read and never written.  Output that grows too large for
+  // memory is moved to the temporary file, and written there from then.
+  class MemoryBuffer : public std::streambuf
+  {
+  public:
+    std::string Content;
+
+    // The buffer of the temporary file, and whether the output has been
+    // moved to it.
+    std::streambuf* File = nullptr;
+    bool Spilled = false;
+
+  protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(char const* s, std::streamsize n) override;
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                     std::ios_base::openmode which) override;
+
+  private:
+    bool Reserve(std::size_t n);
+  };
+  MemoryBuffer Memory;
+
+  // Whether the output is collected in memory.
+  bool InMemory = false;
+
+  // Whether the output is converted to another encoding.
+  bool Encoded = false;
+
+  // Whether the temporary file was opened in binary mode.
+  bool Binary = false;
+
   // The name of the final destination file for the output.
   std::string Name;
 
@@ -69,7 +111,9 @@ protected:
  * version.  This stream is used to make sure file generation is
  * atomic.  Optionally the output file is only replaced if its
  * contents have changed to prevent the file modification time from
- * being updated.
+ * being updated.  In that case the output is collected in memory and
+ * compared with the existing file, and the temporary file is written
+ * only if they differ.
  */
 class cmGeneratedFileStream
   : private cmGeneratedFileStreamBase
@@ -157,4 +201,23 @@ public:
    * Afterward, the original encoding is restored.
    */
   void WriteAltEncoding(std::string const& data, codecvt_Encoding encoding);
+
+  struct Statistics
+  {
+    std::size_t Written = 0;
+    std::size_t Unchanged = 0;
+    unsigned long long UnchangedBytes = 0;
+  };
+
+  /**
+   * Get the number of files replaced so far by copy-if-different
+   * streams, and the number and size of files left untouched because
+   * their content did not change.
+   */
+  static Statistics GetStatistics();
+
+private:
+  // Collect further output in memory if copy-if-different is enabled
+  // and nothing has been written yet.
+  void UseMemoryBuffer();
 };
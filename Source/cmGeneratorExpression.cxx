@@ -106,6 +106,7 @@ std::string const& cmCompiledGeneratorExpression::Evaluate(
 
   if (!eval.HadError) {
     this->HadContextSensitiveCondition = eval.HadContextSensitiveCondition;
+    this->HadConfigSensitiveCondition = eval.HadConfigSensitiveCondition;
     this->HadHeadSensitiveCondition = eval.HadHeadSensitiveCondition;
     this->HadLinkLanguageSensitiveCondition =
       eval.HadLinkLanguageSensitiveCondition;
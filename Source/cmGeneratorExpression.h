@@ -150,6 +150,10 @@ public:
   {
     return this->HadContextSensitiveCondition;
   }
+  bool GetHadConfigSensitiveCondition() const
+  {
+    return this->HadConfigSensitiveCondition;
+  }
   bool GetHadHeadSensitiveCondition() const
   {
     return this->HadHeadSensitiveCondition;
@@ -195,6 +199,7 @@ private:
     MaxLanguageStandard;
   mutable std::string Output;
   mutable bool HadContextSensitiveCondition = false;
+  mutable bool HadConfigSensitiveCondition = false;
   mutable bool HadHeadSensitiveCondition = false;
   mutable bool HadLinkLanguageSensitiveCondition = false;
   mutable std::set<cmGeneratorTarget const*> SourceSensitiveTargets;
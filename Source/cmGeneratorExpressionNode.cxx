@@ -99,6 +99,9 @@ std::string cmGeneratorExpressionNode::EvaluateDependentExpression(
   if (cge->GetHadContextSensitiveCondition()) {
     eval->HadContextSensitiveCondition = true;
   }
+  if (cge->GetHadConfigSensitiveCondition()) {
+    eval->HadConfigSensitiveCondition = true;
+  }
   if (cge->GetHadHeadSensitiveCondition()) {
     eval->HadHeadSensitiveCondition = true;
   }
@@ -132,6 +135,7 @@ static std::string EvaluateBodyWithBoundOperands(
     }
   }
   eval->HadContextSensitiveCondition |= elemEval.HadContextSensitiveCondition;
+  eval->HadConfigSensitiveCondition |= elemEval.HadConfigSensitiveCondition;
   eval->HadHeadSensitiveCondition |= elemEval.HadHeadSensitiveCondition;
   eval->HadLinkLanguageSensitiveCondition |=
     elemEval.HadLinkLanguageSensitiveCondition;
@@ -4430,6 +4434,8 @@ static std::string getLinkedTargetsContent(
   if (cmLinkImplementationLibraries const* impl =
         target->GetLinkImplementationLibraries(
           eval->Context.Config, cmGeneratorTarget::UseTo::Compile)) {
+    eval->HadConfigSensitiveCondition = eval->HadConfigSensitiveCondition ||
+      impl->HadContextSensitiveCondition || impl->HadConfigSensitiveCondition;
     for (cmLinkItem const& lib : impl->Libraries) {
       if (lib.Target) {
         // Pretend $<TARGET_PROPERTY:lib.Target,prop> appeared in our
@@ -4444,6 +4450,10 @@ static std::string getLinkedTargetsContent(
           eval->EvaluateForBuildsystem, lib.Backtrace);
         std::string libResult = lib.Target->EvaluateInterfaceProperty(
           prop, &libEval, dagChecker, usage);
+        eval->HadConfigSensitiveCondition =
+          eval->HadConfigSensitiveCondition ||
+          libEval.HadContextSensitiveCondition ||
+          libEval.HadConfigSensitiveCondition;
         if (!libResult.empty()) {
           if (result.empty()) {
             result = std::move(libResult);
@@ -4595,6 +4605,7 @@ static const struct TargetPropertyNode : public cmGeneratorExpressionNode
           "link libraries for a static library");
         return std::string();
       }
+      eval->HadConfigSensitiveCondition = true;
       return target->GetLinkerLanguage(eval->Context.Config);
     }
 
@@ -4796,6 +4807,7 @@ static const struct targetIntermediateDirNode
       return std::string();
     }
 
+    eval->HadConfigSensitiveCondition = true;
     return cmSystemTools::CollapseFullPath(
       target->GetObjectDirectory(eval->Context.Config));
   }
@@ -4886,6 +4898,7 @@ static const struct TargetObjectsNode : public cmGeneratorExpressionNode
                  tgtName, '"'));
       return std::string();
     }
+    eval->HadConfigSensitiveCondition = true;
     std::set<cmSourceFile const*> sourceFiles;
     for (auto const& sf : gt->GetSourceFiles(eval->Context.Config)) {
       sourceFiles.insert(sf.Value);
@@ -4983,6 +4996,7 @@ struct TargetRuntimeDllsBaseNode : public cmGeneratorExpressionNode
       return std::vector<std::string>();
     }
 
+    eval->HadConfigSensitiveCondition = true;
     if (auto* cli = gt->GetLinkInformation(eval->Context.Config)) {
       std::vector<std::string> dllPaths;
       auto const& dlls = cli->GetRuntimeDLLs();
@@ -5084,6 +5098,7 @@ static const struct CompileFeaturesNode : public cmGeneratorExpressionNode
     }
 
     bool evalLL = dagChecker && dagChecker->EvaluatingLinkLibraries();
+    eval->HadConfigSensitiveCondition = true;
 
     for (auto const& lit : testedFeatures) {
       std::vector<std::string> const& langAvailable =
@@ -5694,6 +5709,8 @@ protected:
       return nullptr;
     }
 
+    // Artifacts are named and placed per configuration.
+    eval->HadConfigSensitiveCondition = true;
     return target;
   }
 };
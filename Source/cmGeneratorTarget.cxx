@@ -43,6 +43,7 @@
 #include "cmMakefile.h"
 #include "cmMessageType.h"
 #include "cmOutputConverter.h"
+#include "cmPathCache.h"
 #include "cmPropertyMap.h"
 #include "cmRulePlaceholderExpander.h"
 #include "cmSourceFile.h"
@@ -547,6 +548,8 @@ void cmGeneratorTarget::ClearSourcesCache()
   this->IncludeDirectoriesCache.clear();
   this->CompileOptionsCache.clear();
   this->CompileDefinitionsCache.clear();
+  this->CompileOptionsAllConfigsCache.clear();
+  this->CompileDefinitionsAllConfigsCache.clear();
   this->CustomTransitiveBuildPropertiesMap.clear();
   this->CustomTransitiveInterfacePropertiesMap.clear();
   this->PrecompileHeadersCache.clear();
@@ -554,12 +557,14 @@ void cmGeneratorTarget::ClearSourcesCache()
   this->LinkDirectoriesCache.clear();
   this->RuntimeBinaryFullNameCache.clear();
   this->ImportLibraryFullNameCache.clear();
+  this->InterfacePropertyValues.clear();
 }
 
 void cmGeneratorTarget::ClearLinkInterfaceCache()
 {
   this->LinkInterfaceMap.clear();
   this->LinkInterfaceUsageRequirementsOnlyMap.clear();
+  this->LinkInterfaceLanguagesMap.clear();
 }
 
 void cmGeneratorTarget::AddSourceCommon(std::string const& src, bool before)
@@ -4805,7 +4810,7 @@ bool cmGeneratorTarget::ComputeOutputDir(std::string const& config,
   // Convert the output path to a full path in case it is
   // specified as a relative path.  Treat a relative path as
   // relative to the current output directory for this makefile.
-  out = (cmSystemTools::CollapseFullPath(
+  out = (cmPathCache::CollapseFullPath(
     out, this->LocalGenerator->GetCurrentBinaryDirectory()));
 
   // The generator may add the configuration's subdirectory.
@@ -4873,7 +4878,7 @@ bool cmGeneratorTarget::ComputePDBOutputDir(std::string const& kind,
   // Convert the output path to a full path in case it is
   // specified as a relative path.  Treat a relative path as
   // relative to the current output directory for this makefile.
-  out = (cmSystemTools::CollapseFullPath(
+  out = (cmPathCache::CollapseFullPath(
     out, this->LocalGenerator->GetCurrentBinaryDirectory()));
 
   // The generator may add the configuration's subdirectory.
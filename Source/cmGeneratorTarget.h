@@ -674,9 +674,22 @@ private:
   mutable ConfigAndLanguageToBTStrings CompileOptionsCache;
   mutable ConfigAndLanguageToBTStrings CompileDefinitionsCache;
   mutable ConfigAndLanguageToBTStrings PrecompileHeadersCache;
+  std::map<std::string, std::vector<BT<std::string>>> AutoPrecompileHeaders;
   mutable ConfigAndLanguageToBTStrings LinkOptionsCache;
   mutable ConfigAndLanguageToBTStrings LinkDirectoriesCache;
 
+  // Compile options and definitions that do not depend on the
+  // configuration are computed once per language and shared by all
+  // configurations.  Sources are already shared when they do not depend
+  // on the configuration, see GetKindedSources.  Object names are stored
+  // once per source, but are visited per configuration to fill in their
+  // per-configuration install locations.  Link information holds the
+  // per-configuration artifacts of dependencies, so it is never shared.
+  using LanguageToBTStrings =
+    std::map<std::string, std::vector<BT<std::string>>>;
+  mutable LanguageToBTStrings CompileOptionsAllConfigsCache;
+  mutable LanguageToBTStrings CompileDefinitionsAllConfigsCache;
+
 public:
   /** Get the include directories for this target.  */
   std::vector<BT<std::string>> GetIncludeDirectories(
@@ -734,6 +747,11 @@ public:
   std::vector<BT<std::string>> GetPrecompileHeaders(
     std::string const& config, std::string const& language) const;
 
+  /** Select precompile headers for PRECOMPILE_HEADERS_AUTO from the
+      dependencies recorded by a previous build, and remember the
+      selection for the next generate.  Called once at generate time.  */
+  void SelectAutoPrecompileHeaders();
+
   void MarkAsPchReused() { this->PchReused = true; }
   cmGeneratorTarget const* GetPchReuseTarget() const;
   cmGeneratorTarget* GetPchReuseTarget();
@@ -1300,6 +1318,24 @@ private:
   mutable LinkInterfaceMapType LinkInterfaceMap;
   mutable LinkInterfaceMapType LinkInterfaceUsageRequirementsOnlyMap;
 
+  // Languages of the transitive link interface closure of this target,
+  // shared by all consumers when no part of the closure depends on the
+  // consuming target.  Consumers that are themselves in the closure
+  // cannot use it, because their own walk stops at themselves.
+  struct LinkInterfaceLanguages
+  {
+    std::vector<std::string> Languages;
+    // Targets in the closure, sorted by address.
+    std::vector<cmGeneratorTarget const*> Targets;
+    bool Computing = false;
+    bool Done = false;
+    bool Shared = false;
+  };
+  mutable std::map<std::string, LinkInterfaceLanguages>
+    LinkInterfaceLanguagesMap;
+  LinkInterfaceLanguages const* GetLinkInterfaceLanguages(
+    std::string const& config, cmGeneratorTarget const* head) const;
+
   cmHeadToLinkInterfaceMap& GetHeadToLinkInterfaceMap(
     std::string const& config) const;
   cmHeadToLinkInterfaceMap& GetHeadToLinkInterfaceUsageRequirementsMap(
@@ -1376,6 +1412,25 @@ private:
                                   cm::GenEx::Evaluation* eval,
                                   UseTo usage) const;
 
+  // Evaluated values of this target's own interface properties that do
+  // not depend on the consuming target, shared by all consumers.
+  struct InterfacePropertyValue
+  {
+    std::string Value;
+    // Set if the value depends on the configuration or language, in
+    // which case it may be reused only from the same directory.
+    cmLocalGenerator const* ContextLG = nullptr;
+    // Set if the value depends on the configuration in a way that does
+    // not make it context-sensitive, such as a target artifact path.
+    bool ConfigSensitive = false;
+  };
+  mutable std::unordered_map<std::string, InterfacePropertyValue>
+    InterfacePropertyValues;
+  std::string EvaluateInterfacePropertyValue(
+    std::string const& prop, std::string const& value,
+    cm::GenEx::Evaluation* eval, cmGeneratorTarget const* headTarget,
+    cmGeneratorExpressionDAGChecker* dagChecker) const;
+
   using TargetPropertyEntryVector =
     std::vector<std::unique_ptr<TargetPropertyEntry>>;
 
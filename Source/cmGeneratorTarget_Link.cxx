@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdio>
+#include <functional>
 #include <map>
 #include <set>
 #include <sstream>
@@ -94,6 +95,16 @@ public:
     if (!this->Visited.insert(item.Target).second) {
       return;
     }
+    if (!this->SecondPass) {
+      // Reuse the closure computed for other consumers, if any.
+      if (cmGeneratorTarget::LinkInterfaceLanguages const* closure =
+            item.Target->GetLinkInterfaceLanguages(this->Config,
+                                                   this->HeadTarget)) {
+        this->Languages.insert(closure->Languages.cbegin(),
+                               closure->Languages.cend());
+        return;
+      }
+    }
     cmLinkInterface const* iface = item.Target->GetLinkInterface(
       this->Config, this->HeadTarget, this->SecondPass);
     if (!iface) {
@@ -126,6 +137,68 @@ private:
   bool HadLinkLanguageSensitiveCondition = false;
 };
 
+cmGeneratorTarget::LinkInterfaceLanguages const*
+cmGeneratorTarget::GetLinkInterfaceLanguages(
+  std::string const& config, cmGeneratorTarget const* head) const
+{
+  LinkInterfaceLanguages& closure =
+    this->LinkInterfaceLanguagesMap[cmSystemTools::UpperCase(config)];
+  if (closure.Done) {
+    return closure.Shared &&
+        !std::binary_search(closure.Targets.cbegin(), closure.Targets.cend(),
+                            head, std::less<cmGeneratorTarget const*>())
+      ? &closure
+      : nullptr;
+  }
+  if (closure.Computing) {
+    // The link interface graph has a cycle through this target.
+    return nullptr;
+  }
+  closure.Computing = true;
+
+  // The closure can be shared only if it is the same for every head
+  // target.  Cycles, which may reach the head itself, and link
+  // interfaces that depend on the head or its link language, are left
+  // to the per-consumer walk.
+  bool shared = true;
+  std::set<std::string> languages;
+  std::set<cmGeneratorTarget const*> targets;
+  targets.insert(this);
+  if (cmLinkInterface const* iface =
+        this->GetLinkInterface(config, head, false)) {
+    shared = !iface->HadHeadSensitiveCondition &&
+      !iface->HadLinkLanguageSensitiveCondition;
+    languages.insert(iface->Languages.cbegin(), iface->Languages.cend());
+    for (cmLinkItem const& lib : iface->Libraries) {
+      if (!shared) {
+        break;
+      }
+      if (!lib.Target) {
+        continue;
+      }
+      LinkInterfaceLanguages const* dep = lib.Target == head
+        ? nullptr
+        : lib.Target->GetLinkInterfaceLanguages(config, head);
+      if (!dep) {
+        shared = false;
+        break;
+      }
+      languages.insert(dep->Languages.cbegin(), dep->Languages.cend());
+      targets.insert(dep->Targets.cbegin(), dep->Targets.cend());
+    }
+  }
+
+  closure.Computing = false;
+  closure.Done = true;
+  closure.Shared = shared;
+  if (shared) {
+    closure.Languages.assign(languages.cbegin(), languages.cend());
+    closure.Targets.assign(targets.cbegin(), targets.cend());
+    return &closure;
+  }
+  return nullptr;
+}
+
 cmGeneratorTarget::LinkClosure const* cmGeneratorTarget::GetLinkClosure(
   std::string const& config) const
 {
@@ -614,6 +687,9 @@ void cmGeneratorTarget::ExpandLinkItems(std::string const& prop,
     if (cge->GetHadContextSensitiveCondition()) {
       iface.HadContextSensitiveCondition = true;
     }
+    if (cge->GetHadConfigSensitiveCondition()) {
+      iface.HadConfigSensitiveCondition = true;
+    }
     if (cge->GetHadLinkLanguageSensitiveCondition()) {
       iface.HadLinkLanguageSensitiveCondition = true;
     }
@@ -1041,6 +1117,9 @@ void TransitiveLinkImpl::Follow(cmGeneratorTarget const* target)
   if (iface->HadContextSensitiveCondition) {
     this->Impl.HadContextSensitiveCondition = true;
   }
+  if (iface->HadConfigSensitiveCondition || target->IsImported()) {
+    this->Impl.HadConfigSensitiveCondition = true;
+  }
 
   // Process 'INTERFACE_LINK_LIBRARIES_DIRECT' usage requirements.
   for (cmLinkItem const& item : iface->HeadInclude) {
@@ -1153,6 +1232,9 @@ void cmGeneratorTarget::ComputeLinkImplementationLibraries(
     if (cge->GetHadContextSensitiveCondition()) {
       impl.HadContextSensitiveCondition = true;
     }
+    if (cge->GetHadConfigSensitiveCondition()) {
+      impl.HadConfigSensitiveCondition = true;
+    }
     if (cge->GetHadLinkLanguageSensitiveCondition()) {
       impl.HadLinkLanguageSensitiveCondition = true;
     }
@@ -250,6 +250,16 @@ MsvcCharSetInfo GetMsvcCharSetInfo(
   return { MsvcCharSet::MultiByte, true };
 }
 
+// Whether values computed from the given entries for one configuration
+// hold for all configurations.  The entries record whether evaluating
+// them consulted the configuration.  The languages whose runtime
+// libraries contribute interface entries come from the sources.
+bool IsConfigIndependent(cmGeneratorTarget const* tgt,
+                         cm::EvaluatedTargetPropertyEntries const& entries)
+{
+  return !entries.DependOnConfig() && !tgt->HasContextDependentSources();
+}
+
 }
 
 void cmGeneratorTarget::GetCompileOptions(std::vector<std::string>& result,
@@ -272,6 +282,10 @@ std::vector<BT<std::string>> cmGeneratorTarget::GetCompileOptions(
     if (it != this->CompileOptionsCache.end()) {
       return it->second;
     }
+    auto shared = this->CompileOptionsAllConfigsCache.find(language);
+    if (shared != this->CompileOptionsAllConfigsCache.end()) {
+      return shared->second;
+    }
   }
   std::vector<BT<std::string>> result;
   std::unordered_set<std::string> uniqueOptions;
@@ -299,7 +313,11 @@ std::vector<BT<std::string>> cmGeneratorTarget::GetCompileOptions(
   processOptions(this, entries, result, uniqueOptions, debugOptions,
                  "compile options", OptionsParse::Shell);
 
-  CompileOptionsCache.emplace(cacheKey, result);
+  if (IsConfigIndependent(this, entries)) {
+    this->CompileOptionsAllConfigsCache.emplace(language, result);
+  } else {
+    this->CompileOptionsCache.emplace(cacheKey, result);
+  }
   return result;
 }
 
@@ -367,6 +385,10 @@ std::vector<BT<std::string>> cmGeneratorTarget::GetCompileDefinitions(
     if (it != this->CompileDefinitionsCache.end()) {
       return it->second;
     }
+    auto shared = this->CompileDefinitionsAllConfigsCache.find(language);
+    if (shared != this->CompileDefinitionsAllConfigsCache.end()) {
+      return shared->second;
+    }
   }
   std::vector<BT<std::string>> list;
   std::unordered_set<std::string> uniqueOptions;
@@ -422,7 +444,11 @@ std::vector<BT<std::string>> cmGeneratorTarget::GetCompileDefinitions(
   processOptions(this, entries, list, uniqueOptions, debugDefines,
                  "compile definitions", OptionsParse::None);
 
-  this->CompileDefinitionsCache.emplace(cacheKey, list);
+  if (IsConfigIndependent(this, entries)) {
+    this->CompileDefinitionsAllConfigsCache.emplace(language, list);
+  } else {
+    this->CompileDefinitionsCache.emplace(cacheKey, list);
+  }
   return list;
 }
 
@@ -463,6 +489,13 @@ std::vector<BT<std::string>> cmGeneratorTarget::GetPrecompileHeaders(
   processOptions(this, entries, list, uniqueOptions, debugDefines,
                  "precompile headers", OptionsParse::None);
 
+  if (list.empty()) {
+    auto const it = this->AutoPrecompileHeaders.find(language);
+    if (it != this->AutoPrecompileHeaders.end()) {
+      list = it->second;
+    }
+  }
+
   this->PrecompileHeadersCache.emplace(cacheKey, list);
   return list;
 }
@@ -0,0 +1,281 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+/* clang-format off */
+#include "cmGeneratorTarget.h"
+/* clang-format on */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <cm/string_view>
+
+#include "cmsys/FStream.hxx"
+#include "cmsys/RegularExpression.hxx"
+
+#include "cmGeneratedFileStream.h"
+#include "cmGlobalGenerator.h"
+#include "cmListFileCache.h"
+#include "cmList.h"
+#include "cmLocalGenerator.h"
+#include "cmMakefile.h"
+#include "cmMessageType.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+#include "cmValue.h"
+#include "cmake.h"
+
+namespace {
+// A header is precompiled if at least this many sources include it
+// directly, and if they make up at least half of the target's sources.
+std::size_t const MinIncludingSources = 2;
+
+using ObjectDepends = std::vector<std::string>;
+
+// Read the dependencies recorded for each object file in an internal
+// depends file written by the Makefile generators.
+void ReadDependsFile(std::string const& file, std::string const& base,
+                     std::vector<ObjectDepends>& objects)
+{
+  cmsys::ifstream fin(file.c_str());
+  if (!fin) {
+    return;
+  }
+  ObjectDepends* current = nullptr;
+  std::string line;
+  while (cmSystemTools::GetLineFromStream(fin, line)) {
+    if (line.empty() || line.front() == '#') {
+      continue;
+    }
+    if (line.front() != ' ') {
+      objects.emplace_back();
+      current = &objects.back();
+      continue;
+    }
+    if (current) {
+      std::string dep = cmSystemTools::CollapseFullPath(line.substr(1), base);
+      cmSystemTools::ConvertToUnixSlashes(dep);
+      current->emplace_back(std::move(dep));
+    }
+  }
+}
+
+struct Include
+{
+  char Delimiter;
+  std::string Name;
+};
+
+// Collect the include directives that appear in a source file.
+void ScanIncludes(std::string const& file, std::vector<Include>& includes)
+{
+  static cmsys::RegularExpression const includeRegex(
+    "^[ \t]*[#%][ \t]*(include|import)[ \t]*([<\"])([^\">]+)[\">]");
+  cmsys::ifstream fin(file.c_str());
+  if (!fin) {
+    return;
+  }
+  cmsys::RegularExpressionMatch match;
+  std::string line;
+  while (cmSystemTools::GetLineFromStream(fin, line)) {
+    if (includeRegex.find(line.c_str(), match)) {
+      std::string name = match.match(3);
+      cmSystemTools::ConvertToUnixSlashes(name);
+      includes.push_back({ match.match(2)[0], std::move(name) });
+    }
+  }
+}
+
+struct Candidate
+{
+  std::string Path;
+  std::size_t Count = 0;
+};
+
+// The headers included by the sources of one language.
+struct LanguageCandidates
+{
+  std::vector<std::string> Order;
+  std::unordered_map<std::string, Candidate> Candidates;
+  std::size_t Sources = 0;
+};
+
+std::array<std::string, 4> const AutoPchLanguages = { { "C", "CXX", "OBJC",
+                                                        "OBJCXX" } };
+}
+
+void cmGeneratorTarget::SelectAutoPrecompileHeaders()
+{
+  if (!this->GetPropertyAsBool("PRECOMPILE_HEADERS_AUTO") ||
+      this->GetProperty("PRECOMPILE_HEADERS") ||
+      this->GetPropertyAsBool("DISABLE_PRECOMPILE_HEADERS") ||
+      this->GetProperty("PRECOMPILE_HEADERS_REUSE_FROM")) {
+    return;
+  }
+
+  // Only the Makefile generators keep the dependencies of a previous
+  // build in a form that can be read here.  They drop them when they
+  // generate, so remember the selection until the next build records
+  // them again.
+  std::string const& topBinary = this->LocalGenerator->GetBinaryDirectory();
+  std::string const targetDir = this->GetSupportDirectory();
+  auto selectionFile = [&targetDir](std::string const& language) {
+    return cmStrCat(targetDir, "/cmake_pch_auto_", language, ".txt");
+  };
+  std::vector<ObjectDepends> objects;
+  for (char const* name : { "compiler_depend.internal", "depend.internal" }) {
+    ReadDependsFile(cmStrCat(targetDir, '/', name), topBinary, objects);
+  }
+  if (objects.empty()) {
+    for (std::string const& language : AutoPchLanguages) {
+      cmsys::ifstream fin(selectionFile(language).c_str());
+      std::string line;
+      while (fin && cmSystemTools::GetLineFromStream(fin, line)) {
+        if (!line.empty()) {
+          this->AutoPrecompileHeaders[language].emplace_back(
+            line, this->GetBacktrace());
+        }
+      }
+    }
+    return;
+  }
+
+  // Headers of the project itself are likely to change, so only consider
+  // headers found outside of its source and binary trees.
+  std::string const& topSource = this->Makefile->GetHomeDirectory();
+  auto isExternal = [&topSource, &topBinary](std::string const& path) {
+    return !cmSystemTools::IsSubDirectory(path, topSource) &&
+      !cmSystemTools::IsSubDirectory(path, topBinary);
+  };
+  cmGlobalGenerator const* gg = this->GetGlobalGenerator();
+  auto languageOf = [gg](std::string const& path) {
+    return gg->GetLanguageFromExtension(
+      cmSystemTools::GetFilenameLastExtensionView(path));
+  };
+
+  std::unordered_map<std::string, LanguageCandidates> byLanguage;
+  for (ObjectDepends const& depends : objects) {
+    // The source is the first dependency with a language.  Skip the
+    // objects that build a PCH itself.
+    std::string const* source = nullptr;
+    for (std::string const& dep : depends) {
+      if (!languageOf(dep).empty()) {
+        source = &dep;
+        break;
+      }
+    }
+    if (!source ||
+        cmHasLiteralPrefix(cmSystemTools::GetFilenameNameView(*source),
+                           "cmake_pch")) {
+      continue;
+    }
+    LanguageCandidates& lc = byLanguage[std::string(languageOf(*source))];
+    ++lc.Sources;
+
+    std::unordered_map<cm::string_view, std::vector<std::string const*>>
+      byName;
+    for (std::string const& dep : depends) {
+      byName[cmSystemTools::GetFilenameNameView(dep)].push_back(&dep);
+    }
+    auto resolve = [&byName](std::string const& name) -> std::string const* {
+      auto const it = byName.find(cmSystemTools::GetFilenameNameView(name));
+      if (it != byName.end() && name.find("..") == std::string::npos) {
+        for (std::string const* path : it->second) {
+          if (path->size() > name.size() &&
+              cmHasSuffix(*path, cmStrCat('/', name))) {
+            return path;
+          }
+        }
+      }
+      return nullptr;
+    };
+
+    // Scan the source for the headers it includes directly.  A unity
+    // source includes other sources, so scan those as well.
+    std::vector<Include> includes;
+    ScanIncludes(*source, includes);
+    std::size_t const direct = includes.size();
+    for (std::size_t i = 0; i < direct; ++i) {
+      std::string const* path = resolve(includes[i].Name);
+      if (path && !languageOf(*path).empty()) {
+        ScanIncludes(*path, includes);
+      }
+    }
+
+    std::unordered_set<std::string> seen;
+    for (Include const& include : includes) {
+      std::string const* path = resolve(include.Name);
+      if (!path || !languageOf(*path).empty() || !isExternal(*path)) {
+        continue;
+      }
+      std::string key = include.Delimiter == '<'
+        ? cmStrCat('<', include.Name, '>')
+        : cmStrCat('"', include.Name, '"');
+      if (!seen.insert(key).second) {
+        continue;
+      }
+      Candidate& candidate = lc.Candidates[key];
+      if (candidate.Count == 0) {
+        candidate.Path = *path;
+        lc.Order.emplace_back(std::move(key));
+      }
+      ++candidate.Count;
+    }
+  }
+
+  cmList debugProperties{ this->Makefile->GetDefinition(
+    "CMAKE_DEBUG_TARGET_PROPERTIES") };
+  bool const debug =
+    std::find(debugProperties.begin(), debugProperties.end(),
+              "PRECOMPILE_HEADERS") != debugProperties.end();
+
+  for (std::string const& language : AutoPchLanguages) {
+    std::vector<BT<std::string>>& headers =
+      this->AutoPrecompileHeaders[language];
+    LanguageCandidates& lc = byLanguage[language];
+    std::string report;
+    unsigned long long saved = 0;
+    for (std::string const& key : lc.Order) {
+      Candidate const& candidate = lc.Candidates[key];
+      if (candidate.Count < MinIncludingSources ||
+          candidate.Count * 2 < lc.Sources ||
+          !cmSystemTools::FileExists(candidate.Path, true)) {
+        continue;
+      }
+      headers.emplace_back(key, this->GetBacktrace());
+      if (debug) {
+        unsigned long long const size =
+          cmSystemTools::FileLength(candidate.Path);
+        saved += size * (candidate.Count - 1);
+        report += cmStrCat(" * ", key, " (", candidate.Count, " sources, ",
+                           size, " bytes)\n");
+      }
+    }
+
+    if (headers.empty()) {
+      cmSystemTools::RemoveFile(selectionFile(language));
+    } else {
+      cmGeneratedFileStream fout(selectionFile(language));
+      fout.SetCopyIfDifferent(true);
+      for (BT<std::string> const& header : headers) {
+        fout << header.Value << '\n';
+      }
+    }
+
+    if (!report.empty()) {
+      this->LocalGenerator->GetCMakeInstance()->IssueMessage(
+        MessageType::LOG,
+        cmStrCat("Automatically selected ", language,
+                 " precompile headers for target ", this->GetName(),
+                 " from ", lc.Sources, " sources:\n", report,
+                 "Estimated parsing saved per build: ", saved,
+                 " bytes of headers, excluding their own includes\n"),
+        this->GetBacktrace());
+    }
+  }
+}
@@ -5,6 +5,7 @@
 /* clang-format on */
 
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -26,6 +27,7 @@
 #include "cmLocalGenerator.h"
 #include "cmPolicies.h"
 #include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
 #include "cmValue.h"
 
 namespace {
@@ -138,14 +140,18 @@ std::string cmGeneratorTarget::EvaluateInterfaceProperty(
     eval->HeadTarget ? eval->HeadTarget : this;
 
   if (cmValue p = this->GetProperty(prop)) {
-    result = cmGeneratorExpressionNode::EvaluateDependentExpression(
-      *p, eval, headTarget, &dagChecker, this);
+    result = this->EvaluateInterfacePropertyValue(prop, *p, eval, headTarget,
+                                                  &dagChecker);
   }
 
   if (cmLinkInterfaceLibraries const* iface = this->GetLinkInterfaceLibraries(
         eval->Context.Config, headTarget, usage)) {
     eval->HadContextSensitiveCondition = eval->HadContextSensitiveCondition ||
       iface->HadContextSensitiveCondition;
+    // The link interface of an imported target is selected by mapping
+    // the configuration to one of its imported configurations.
+    eval->HadConfigSensitiveCondition = eval->HadConfigSensitiveCondition ||
+      iface->HadConfigSensitiveCondition || this->IsImported();
     for (cmLinkItem const& lib : iface->Libraries) {
       // Broken code can have a target in its own link interface.
       // Don't follow such link interface entries so as not to create a
@@ -172,6 +178,9 @@ std::string cmGeneratorTarget::EvaluateInterfaceProperty(
         eval->HadContextSensitiveCondition =
           eval->HadContextSensitiveCondition ||
           libEval.HadContextSensitiveCondition;
+        eval->HadConfigSensitiveCondition =
+          eval->HadConfigSensitiveCondition ||
+          libEval.HadConfigSensitiveCondition;
         eval->HadHeadSensitiveCondition =
           eval->HadHeadSensitiveCondition || libEval.HadHeadSensitiveCondition;
       }
@@ -181,6 +190,78 @@ std::string cmGeneratorTarget::EvaluateInterfaceProperty(
   return result;
 }
 
+std::string cmGeneratorTarget::EvaluateInterfacePropertyValue(
+  std::string const& prop, std::string const& value,
+  cm::GenEx::Evaluation* eval, cmGeneratorTarget const* headTarget,
+  cmGeneratorExpressionDAGChecker* dagChecker) const
+{
+  // Plain values evaluate to themselves.
+  if (cmGeneratorExpression::Find(value) == std::string::npos) {
+    return value;
+  }
+
+  // Expressions bound to operands of an enclosing expression are not
+  // shared.  Neither are values evaluated for link libraries: there
+  // $<LINK_ONLY> and $<COMPILE_ONLY> depend on the outermost evaluation.
+  if (eval->Context.BoundOperandCount() > 0 ||
+      dagChecker->EvaluatingLinkLibraries()) {
+    return cmGeneratorExpressionNode::EvaluateDependentExpression(
+      value, eval, headTarget, dagChecker, this);
+  }
+
+  std::string const key =
+    cmStrCat(prop, '@', eval->Context.Config, '@', eval->Context.Language,
+             eval->EvaluateForBuildsystem ? "@buildsystem" : "",
+             eval->Quiet ? "@quiet" : "");
+  auto i = this->InterfacePropertyValues.find(key);
+  if (i != this->InterfacePropertyValues.end() &&
+      (!i->second.ContextLG || i->second.ContextLG == eval->Context.LG)) {
+    if (i->second.ContextLG) {
+      eval->HadContextSensitiveCondition = true;
+    }
+    if (i->second.ConfigSensitive) {
+      eval->HadConfigSensitiveCondition = true;
+    }
+    return i->second.Value;
+  }
+
+  cmGeneratorExpression ge(*eval->Context.LG->GetCMakeInstance(),
+                           eval->Backtrace);
+  std::unique_ptr<cmCompiledGeneratorExpression> cge = ge.Parse(value);
+  cge->SetEvaluateForBuildsystem(eval->EvaluateForBuildsystem);
+  cge->SetQuiet(eval->Quiet);
+  std::string result =
+    cge->Evaluate(eval->Context, dagChecker, headTarget, this);
+  if (cge->GetHadContextSensitiveCondition()) {
+    eval->HadContextSensitiveCondition = true;
+  }
+  if (cge->GetHadConfigSensitiveCondition()) {
+    eval->HadConfigSensitiveCondition = true;
+  }
+  if (cge->GetHadHeadSensitiveCondition()) {
+    eval->HadHeadSensitiveCondition = true;
+  }
+  if (cge->GetHadLinkLanguageSensitiveCondition()) {
+    eval->HadLinkLanguageSensitiveCondition = true;
+  }
+
+  // Share the value with other consumers only if it does not depend on
+  // the head target or its link language, and does not refer to other
+  // targets whose evaluation depends on what the consumer has seen.
+  if (!cge->GetHadHeadSensitiveCondition() &&
+      !cge->GetHadLinkLanguageSensitiveCondition() &&
+      cge->GetAllTargetsSeen().empty() &&
+      cge->GetSeenTargetProperties().empty() &&
+      !cmSystemTools::GetFatalErrorOccurred()) {
+    InterfacePropertyValue& entry = this->InterfacePropertyValues[key];
+    entry.Value = result;
+    entry.ContextLG =
+      cge->GetHadContextSensitiveCondition() ? eval->Context.LG : nullptr;
+    entry.ConfigSensitive = cge->GetHadConfigSensitiveCondition();
+  }
+  return result;
+}
+
 cm::optional<cmGeneratorTarget::TransitiveProperty>
 cmGeneratorTarget::IsTransitiveProperty(
   cm::string_view prop, cm::GenEx::Context const& context,
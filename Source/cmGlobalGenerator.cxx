@@ -56,6 +56,7 @@
 #include "cmMakefile.h"
 #include "cmMessageType.h"
 #include "cmOutputConverter.h"
+#include "cmPathCache.h"
 #include "cmPolicies.h"
 #include "cmRange.h"
 #include "cmSbomArguments.h"
@@ -1872,6 +1873,9 @@ bool cmGlobalGenerator::Compute()
 
 void cmGlobalGenerator::Generate()
 {
+  // Start with no path results memoized by a previous generate step.
+  cmPathCache::ClearShared();
+
   // Create a map from local generator to the complete set of targets
   // it builds by default.
   this->InitializeProgressMarks();
@@ -2220,6 +2224,7 @@ bool cmGlobalGenerator::AddAutomaticSources()
       if (!gt->CanCompileSources()) {
         continue;
       }
+      gt->SelectAutoPrecompileHeaders();
       lg->AddUnityBuild(gt.get());
       lg->AddISPCDependencies(gt.get());
       // Targets that reuse a PCH are handled below.
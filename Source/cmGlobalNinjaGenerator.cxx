@@ -43,6 +43,7 @@
 #include "cmMessageType.h"
 #include "cmNinjaLinkLineComputer.h"
 #include "cmOutputConverter.h"
+#include "cmPathCache.h"
 #include "cmRange.h"
 #include "cmScanDepFormat.h"
 #include "cmScriptGenerator.h"
@@ -1246,7 +1247,7 @@ void cmGlobalNinjaGenerator::AddCXXCompileCommand(
   }
 
   std::string sourceFileName =
-    cmSystemTools::CollapseFullPath(sourceFile, buildFileDir);
+    cmPathCache::CollapseFullPath(sourceFile, buildFileDir);
 
   /* clang-format off */
   *this->CompileCommandsStream << "{\n"
@@ -1258,7 +1259,7 @@ void cmGlobalNinjaGenerator::AddCXXCompileCommand(
      << cmGlobalGenerator::EscapeJSON(sourceFileName) << "\",\n"
      << R"(  "output": ")"
      << cmGlobalGenerator::EscapeJSON(
-           cmSystemTools::CollapseFullPath(objPath, buildFileDir))
+           cmPathCache::CollapseFullPath(objPath, buildFileDir))
            << "\"\n"
      << "}";
   /* clang-format on */
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <chrono>
 #include <ctime>
+#include <functional>
 #include <iomanip>
 #include <iterator>
 #include <set>
@@ -39,6 +40,7 @@
 #include "cmState.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
+#include "cmTargetDepend.h"
 #include "cmTargetTypes.h"
 #include "cmTimestamp.h"
 #include "cmUVProcessChain.h"
@@ -265,12 +267,41 @@ Json::Value cmInstrumentation::DumpTargets(
         target["labels"].append(item);
       }
       target["type"] = cmState::GetTargetTypeName(gt->GetType()).c_str();
+      target["dependencies"] = Json::arrayValue;
+      for (std::string const& dep : this->GetTargetDependencies(gg, gt)) {
+        target["dependencies"].append(dep);
+      }
       targets[gt->GetName()] = target;
     }
   }
   return targets;
 }
 
+std::set<std::string> cmInstrumentation::GetTargetDependencies(
+  std::unique_ptr<cmGlobalGenerator> const& gg, cmGeneratorTarget const* gt)
+{
+  // Report dependencies on other instrumentable targets, looking through
+  // any other targets (such as custom targets) in between.
+  std::set<std::string> dependencies;
+  std::set<cmGeneratorTarget const*> visited;
+  std::vector<cmGeneratorTarget const*> queue{ gt };
+  while (!queue.empty()) {
+    cmGeneratorTarget const* current = queue.back();
+    queue.pop_back();
+    for (cmTargetDepend const& dep : gg->GetTargetDirectDepends(current)) {
+      if (!visited.insert(dep).second) {
+        continue;
+      }
+      if (this->IsInstrumentableTargetType(dep->GetType())) {
+        dependencies.insert(dep->GetName());
+      } else {
+        queue.push_back(dep);
+      }
+    }
+  }
+  return dependencies;
+}
+
 std::string cmInstrumentation::GetFileByTimestamp(
   cmInstrumentation::LatestOrOldest order, std::string const& dataSubdir,
   std::string const& exclude)
@@ -406,10 +437,17 @@ int cmInstrumentation::CollectTimingData(cmInstrumentationQuery::Hook hook)
     }
   }
 
+  // Compute the chain of dependent targets that bounded the build time
+  Json::Value criticalPath = Json::nullValue;
+  if (this->HasOption(cmInstrumentationQuery::Option::CriticalPath)) {
+    criticalPath = this->ComputeCriticalPath(index);
+    index["criticalPath"] = criticalPath;
+  }
+
   // Parse snippets into the Google trace file
   if (this->HasOption(cmInstrumentationQuery::Option::Trace)) {
     std::string trace_name = cmStrCat("trace-", suffix_time, ".json");
-    this->WriteTraceFile(index, trace_name);
+    this->WriteTraceFile(index, trace_name, criticalPath);
     index["trace"] = cmStrCat("trace/", trace_name);
   }
 
@@ -1178,8 +1216,119 @@ void cmInstrumentation::CollectCompileTraceFile(Json::Value& root,
   root["traceFile"] = copiedFile;
 }
 
+Json::Value cmInstrumentation::ComputeCriticalPath(Json::Value const& index)
+{
+  struct TargetTiming
+  {
+    bool HasTiming = false;
+    uint64_t TimeStart = 0;
+    uint64_t TimeEnd = 0;
+    std::vector<std::string> Dependencies;
+    // Longest chain of dependent targets ending with this one.
+    cm::optional<uint64_t> PathDuration;
+    std::string PathPrevious;
+  };
+  std::map<std::string, TargetTiming> targets;
+
+  // Span the commands of each target that ran since the previous indexing.
+  std::string contentFile;
+  for (auto const& f : index["snippets"]) {
+    Json::Value snippetData = this->ReadJsonSnippet(f.asString());
+    std::string const role = snippetData["role"].asString();
+    if ((role != "compile" && role != "link" && role != "custom") ||
+        !snippetData["target"].isString()) {
+      continue;
+    }
+    uint64_t const timeStart = snippetData["timeStart"].asUInt64();
+    uint64_t const timeEnd = timeStart + snippetData["duration"].asUInt64();
+    TargetTiming& timing = targets[snippetData["target"].asString()];
+    if (!timing.HasTiming || timeStart < timing.TimeStart) {
+      timing.TimeStart = timeStart;
+    }
+    if (!timing.HasTiming || timeEnd > timing.TimeEnd) {
+      timing.TimeEnd = timeEnd;
+    }
+    timing.HasTiming = true;
+    if (snippetData["cmakeContent"].isString()) {
+      contentFile =
+        std::max(contentFile, snippetData["cmakeContent"].asString());
+    }
+  }
+
+  // Dependencies between targets are recorded in the CMake content file.
+  if (!contentFile.empty()) {
+    Json::Value content = this->ReadJsonSnippet(contentFile);
+    Json::Value const& contentTargets = content["targets"];
+    if (contentTargets.isObject()) {
+      for (auto const& name : contentTargets.getMemberNames()) {
+        for (auto const& dep : contentTargets[name]["dependencies"]) {
+          targets[name].Dependencies.push_back(dep.asString());
+        }
+      }
+    }
+  }
+
+  std::function<uint64_t(std::string const&)> longestPath =
+    [&targets, &longestPath](std::string const& name) -> uint64_t {
+    TargetTiming& timing = targets[name];
+    if (timing.PathDuration) {
+      return *timing.PathDuration;
+    }
+    // Guard against dependency cycles among static libraries.
+    timing.PathDuration = 0;
+    uint64_t longest = 0;
+    std::string previous;
+    for (std::string const& dep : timing.Dependencies) {
+      uint64_t const duration = longestPath(dep);
+      if (duration > longest) {
+        longest = duration;
+        previous = dep;
+      }
+    }
+    if (timing.HasTiming) {
+      longest += timing.TimeEnd - timing.TimeStart;
+    }
+    timing.PathDuration = longest;
+    timing.PathPrevious = std::move(previous);
+    return longest;
+  };
+
+  uint64_t duration = 0;
+  std::string last;
+  for (auto const& target : targets) {
+    uint64_t const pathDuration = longestPath(target.first);
+    if (pathDuration > duration) {
+      duration = pathDuration;
+      last = target.first;
+    }
+  }
+
+  std::vector<std::string> path;
+  for (std::string name = last; !name.empty();
+       name = targets[name].PathPrevious) {
+    if (targets[name].HasTiming) {
+      path.push_back(name);
+    }
+  }
+
+  Json::Value criticalPath = Json::objectValue;
+  criticalPath["duration"] = static_cast<Json::Value::UInt64>(duration);
+  criticalPath["targets"] = Json::arrayValue;
+  for (auto it = path.rbegin(); it != path.rend(); ++it) {
+    TargetTiming const& timing = targets[*it];
+    Json::Value target = Json::objectValue;
+    target["name"] = *it;
+    target["timeStart"] = static_cast<Json::Value::UInt64>(timing.TimeStart);
+    target["duration"] =
+      static_cast<Json::Value::UInt64>(timing.TimeEnd - timing.TimeStart);
+    criticalPath["targets"].append(target);
+  }
+  return criticalPath;
+}
+
 void cmInstrumentation::WriteTraceFile(Json::Value const& index,
-                                       std::string const& trace_name)
+                                       std::string const& trace_name,
+                                       Json::Value const& criticalPath)
 {
   std::vector<std::string> snippets = std::vector<std::string>();
   for (auto const& f : index["snippets"]) {
@@ -1243,6 +1392,30 @@ void cmInstrumentation::WriteTraceFile(Json::Value const& index,
     }
   }
 
+  // Show the critical path on its own lane, after the job slots.
+  bool first = snippets.empty();
+  for (auto const& target : criticalPath["targets"]) {
+    traceEvent = Json::objectValue;
+    traceEvent["name"] =
+      cmStrCat("critical path: ", target["name"].asString());
+    traceEvent["cat"] = "criticalPath";
+    traceEvent["ph"] = "X";
+    traceEvent["ts"] = target["timeStart"].asUInt64() * 1000;
+    traceEvent["dur"] = target["duration"].asUInt64() * 1000;
+    traceEvent["pid"] = 0;
+    traceEvent["tid"] = static_cast<Json::Value::UInt64>(workers.size() + 1);
+    traceEvent["args"] = target;
+    try {
+      if (!first) {
+        traceStream << ",";
+      }
+      first = false;
+      jsonWriter->write(traceEvent, &traceStream);
+    } catch (...) {
+      cmSystemTools::Error("Error writing Google trace output.");
+    }
+  }
+
   try {
     traceStream << "]\n";
     traceStream.close();
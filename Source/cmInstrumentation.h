@@ -25,6 +25,7 @@
 #include "cmFileLock.h"
 #include "cmInstrumentationQuery.h"
 
+class cmGeneratorTarget;
 class cmGlobalGenerator;
 
 namespace cm {
@@ -80,6 +81,9 @@ public:
   void AddCustomContent(std::string const& name, Json::Value const& contents);
   void WriteCMakeContent(std::unique_ptr<cmGlobalGenerator> const& gg);
   Json::Value DumpTargets(std::unique_ptr<cmGlobalGenerator> const& gg);
+  std::set<std::string> GetTargetDependencies(
+    std::unique_ptr<cmGlobalGenerator> const& gg,
+    cmGeneratorTarget const* gt);
   void ClearGeneratedQueries();
   int CollectTimingData(cmInstrumentationQuery::Hook hook);
   int SpawnBuildDaemon();
@@ -138,7 +142,9 @@ private:
                                std::string const& suffixTime);
   void RemoveCompileTraceFile(Json::Value const& snippetData);
   void RemoveOldFiles(std::string const& dataSubdir);
-  void WriteTraceFile(Json::Value const& index, std::string const& trace_name);
+  Json::Value ComputeCriticalPath(Json::Value const& index);
+  void WriteTraceFile(Json::Value const& index, std::string const& trace_name,
+                      Json::Value const& criticalPath);
   Json::Value BuildTraceEvent(std::vector<uint64_t>& workers,
                               Json::Value const& snippetData);
   size_t AssignTargetToTraceThread(std::vector<uint64_t>& workers,
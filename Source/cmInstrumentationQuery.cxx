@@ -21,7 +21,8 @@ std::vector<std::string> const cmInstrumentationQuery::OptionString{
   "compileTrace",
   "cdashSubmit",
   "cdashVerbose",
-  "trace"
+  "trace",
+  "criticalPath"
 };
 std::vector<std::string> const cmInstrumentationQuery::HookString{
   "postGenerate",    "preBuild",  "postBuild",        "preCMakeBuild",
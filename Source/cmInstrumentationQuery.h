@@ -20,7 +20,8 @@ public:
     CompileTrace,
     CDashSubmit,
     CDashVerbose,
-    Trace
+    Trace,
+    CriticalPath
   };
   static std::vector<std::string> const OptionString;
 
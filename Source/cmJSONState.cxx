@@ -125,25 +125,38 @@ void cmJSONState::pop_stack()
 void cmJSONState::ReadJSONStream(std::istream& jsonIStream, Json::Value* root,
                                  StrictMode strictMode)
 {
-  // Save the entire document.
-  std::streampos inBegin = jsonIStream.tellg();
-  this->doc = std::string(std::istreambuf_iterator<char>(jsonIStream),
-                          std::istreambuf_iterator<char>());
+  // Save the entire document.  Read it in one block when the size of
+  // the stream is known, and parse the saved copy.
+  std::streampos const inBegin = jsonIStream.tellg();
+  if (inBegin != std::streampos(-1) &&
+      jsonIStream.seekg(0, std::ios::end)) {
+    std::streamoff const size = jsonIStream.tellg() - inBegin;
+    jsonIStream.seekg(inBegin);
+    this->doc.resize(static_cast<std::string::size_type>(size));
+    jsonIStream.read(&this->doc[0], size);
+    this->doc.resize(
+      static_cast<std::string::size_type>(jsonIStream.gcount()));
+  } else {
+    jsonIStream.clear();
+    this->doc = std::string(std::istreambuf_iterator<char>(jsonIStream),
+                            std::istreambuf_iterator<char>());
+  }
   if (this->doc.empty()) {
     this->AddError("A JSON document cannot be empty");
     return;
   }
-  jsonIStream.seekg(inBegin);
 
   Json::CharReaderBuilder builder;
   if (strictMode == StrictMode::Strict) {
     Json::CharReaderBuilder::strictMode(&builder.settings_);
   }
+  // Comments are never read back from the values.
+  builder["collectComments"] = false;
+  std::unique_ptr<Json::CharReader> const reader(builder.newCharReader());
   std::string errMsg;
 
 #if JSONCPP_VERSION_HEXA >= 0x01090600
   // Has StructuredError
-  std::unique_ptr<Json::CharReader> const reader(builder.newCharReader());
   reader->parse(this->doc.data(), this->doc.data() + this->doc.size(), root,
                 &errMsg);
   std::vector<Json::CharReader::StructuredError> structuredErrors =
@@ -154,7 +167,8 @@ void cmJSONState::ReadJSONStream(std::istream& jsonIStream, Json::Value* root,
   }
 #else
   // No StructuredError Available, Use error string from jsonCpp
-  if (!Json::parseFromStream(builder, jsonIStream, root, &errMsg)) {
+  if (!reader->parse(this->doc.data(), this->doc.data() + this->doc.size(),
+                     root, &errMsg)) {
     if (this->Filename.empty()) {
       errMsg = cmStrCat("JSON Parse Error:\n ", errMsg);
     } else {
@@ -0,0 +1,136 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+#include "cmLDConfigLDSOCacheTool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <cm/string_view>
+#include <cmext/string_view>
+
+#include "cmsys/FStream.hxx"
+
+#include "cmRuntimeDependencyArchive.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+namespace {
+// The layout of the cache is defined by glibc's dl-cache.h.  The file may
+// start with a table in the old format, followed by one in the new format.
+cm::static_string_view const CacheMagicOld = "ld.so-1.7.0"_s;
+std::size_t const CacheHeaderOldSize = 16;
+std::size_t const CacheEntryOldSize = 12;
+
+cm::static_string_view const CacheMagicNew = "glibc-ld.so.cache1.1"_s;
+std::size_t const CacheHeaderNewSize = 48;
+std::size_t const CacheEntryNewSize = 24;
+
+std::uint32_t ReadUInt32(std::string const& data, std::size_t pos)
+{
+  std::uint32_t value;
+  std::memcpy(&value, data.data() + pos, sizeof(value));
+  return value;
+}
+
+bool HasMagic(std::string const& data, std::size_t pos,
+              cm::static_string_view magic)
+{
+  return pos <= data.size() &&
+    data.compare(pos, magic.size(), magic.data(), magic.size()) == 0;
+}
+
+// Read the library paths of a table whose entries start at 'entries' and
+// whose string offsets are relative to 'strings'.
+bool ReadCacheEntries(std::string const& data, std::size_t entries,
+                      std::size_t entrySize, std::uint32_t count,
+                      std::size_t strings, std::vector<std::string>& files)
+{
+  if (entries + std::size_t(count) * entrySize > data.size()) {
+    return false;
+  }
+  for (std::uint32_t i = 0; i < count; ++i) {
+    // Each entry starts with 'int32_t flags; uint32_t key, value;'.
+    std::size_t const value =
+      strings + ReadUInt32(data, entries + i * entrySize + 8);
+    std::size_t const end = data.find('\0', value);
+    if (value >= data.size() || end == std::string::npos) {
+      return false;
+    }
+    files.emplace_back(data, value, end - value);
+  }
+  return true;
+}
+}
+
+std::string const cmLDConfigLDSOCacheTool::CacheFile = "/etc/ld.so.cache";
+
+cmLDConfigLDSOCacheTool::cmLDConfigLDSOCacheTool(
+  cmRuntimeDependencyArchive* archive)
+  : cmLDConfigTool(archive)
+{
+}
+
+bool cmLDConfigLDSOCacheTool::GetLDConfigPaths(std::vector<std::string>& paths)
+{
+  cmsys::ifstream fin(CacheFile.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    this->Archive->SetError(cmStrCat("Failed to open ", CacheFile));
+    return false;
+  }
+  std::string const data{ std::istreambuf_iterator<char>(fin),
+                          std::istreambuf_iterator<char>() };
+
+  std::vector<std::string> files;
+  std::size_t newTable = std::string::npos;
+  bool valid = false;
+  if (HasMagic(data, 0, CacheMagicNew)) {
+    newTable = 0;
+  } else if (HasMagic(data, 0, CacheMagicOld) &&
+             data.size() >= CacheHeaderOldSize) {
+    std::uint32_t const count = ReadUInt32(data, 12);
+    std::size_t const strings =
+      CacheHeaderOldSize + std::size_t(count) * CacheEntryOldSize;
+    // A table in the new format may follow, aligned to 8 bytes.
+    std::size_t const aligned = (strings + 7) & ~std::size_t(7);
+    if (HasMagic(data, aligned, CacheMagicNew)) {
+      newTable = aligned;
+    } else {
+      // Strings of the old format are relative to the end of its table.
+      valid = ReadCacheEntries(data, CacheHeaderOldSize, CacheEntryOldSize,
+                               count, strings, files);
+    }
+  }
+  if (newTable != std::string::npos &&
+      data.size() >= newTable + CacheHeaderNewSize) {
+    // Strings of the new format are relative to the start of its header.
+    valid = ReadCacheEntries(
+      data, newTable + CacheHeaderNewSize, CacheEntryNewSize,
+      ReadUInt32(data, newTable + 20), newTable, files);
+  }
+  if (!valid) {
+    this->Archive->SetError(cmStrCat("Failed to parse ", CacheFile));
+    return false;
+  }
+
+  // Report the directories in the order ld.so prefers their libraries,
+  // followed by the trusted directories it always searches.
+  std::set<std::string> seen;
+  for (std::string const& file : files) {
+    std::string dir = cmSystemTools::GetFilenamePath(file);
+    if (seen.insert(dir).second) {
+      paths.push_back(std::move(dir));
+    }
+  }
+  for (std::string dir : { "/lib64", "/usr/lib64", "/lib", "/usr/lib" }) {
+    if (seen.insert(dir).second && cmSystemTools::FileIsDirectory(dir)) {
+      paths.push_back(std::move(dir));
+    }
+  }
+  return true;
+}
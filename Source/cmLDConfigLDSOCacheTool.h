@@ -0,0 +1,22 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cmLDConfigTool.h"
+
+/** \class cmLDConfigLDSOCacheTool
+ * \brief Read the library directories from the glibc ld.so.cache file.
+ */
+class cmLDConfigLDSOCacheTool : public cmLDConfigTool
+{
+public:
+  cmLDConfigLDSOCacheTool(cmRuntimeDependencyArchive* archive);
+
+  bool GetLDConfigPaths(std::vector<std::string>& paths) override;
+
+  static std::string const CacheFile;
+};
@@ -62,6 +62,11 @@ struct cmLinkImplementationLibraries
 
   // Whether the list depends on a genex referencing the configuration.
   bool HadContextSensitiveCondition = false;
+
+  // Whether the list depends on the configuration in another way,
+  // such as through the per-configuration link interface of an
+  // imported target.
+  bool HadConfigSensitiveCondition = false;
 };
 
 struct cmLinkInterfaceLibraries
@@ -83,6 +88,9 @@ struct cmLinkInterfaceLibraries
 
   // Whether the list depends on a genex referencing the configuration.
   bool HadContextSensitiveCondition = false;
+
+  // Whether the list depends on the configuration in another way.
+  bool HadConfigSensitiveCondition = false;
 };
 
 struct cmLinkInterface : public cmLinkInterfaceLibraries
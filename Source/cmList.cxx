@@ -23,6 +23,7 @@
 #include "cmListFileCache.h"
 #include "cmMakefile.h"
 #include "cmRange.h"
+#include "cmRegexCache.h"
 #include "cmState.h"
 #include "cmStateTypes.h"
 #include "cmStringAlgorithms.h"
@@ -237,8 +238,8 @@ private:
 
 cmList& cmList::filter(cm::string_view pattern, FilterMode mode)
 {
-  cmsys::RegularExpression regex(std::string{ pattern });
-  if (!regex.is_valid()) {
+  cmsys::RegularExpression regex;
+  if (!cmRegexCache::Compile(regex, std::string{ pattern })) {
     throw std::invalid_argument(
       cmStrCat("sub-command FILTER, mode REGEX failed to compile regex \"",
                pattern, "\"."));
@@ -485,13 +486,8 @@ class TransformSelectorRegex : public TransformSelector
 public:
   TransformSelectorRegex(std::string const& regex)
     : TransformSelector("REGEX")
-    , Regex(regex)
-  {
-  }
-  TransformSelectorRegex(std::string&& regex)
-    : TransformSelector("REGEX")
-    , Regex(regex)
   {
+    cmRegexCache::Compile(this->Regex, regex);
   }
 
   bool Validate(std::size_t) override { return this->Regex.is_valid(); }
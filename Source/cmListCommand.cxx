@@ -72,17 +72,17 @@ cm::optional<cmList> GetList(std::string const& var,
 {
   cm::optional<cmList> list;
 
-  std::string listString;
-  if (!GetListString(listString, var, makefile)) {
+  cmValue listString = makefile.GetDefinition(var);
+  if (!listString) {
     return list;
   }
   // if the size of the list
-  if (listString.empty()) {
+  if (listString->empty()) {
     list.emplace();
     return list;
   }
   // expand the variable into a list
-  list.emplace(listString, cmList::EmptyElements::Yes);
+  list.emplace(*listString, cmList::EmptyElements::Yes);
   // if no empty elements then just return
   if (!cm::contains(*list, std::string())) {
     return list;
@@ -160,14 +160,9 @@ bool HandleAppendCommand(std::vector<std::string> const& args,
     return true;
   }
 
-  cmMakefile& makefile = status.GetMakefile();
-  std::string const& listName = args[1];
-  // expand the variable
-  std::string listString;
-  GetListString(listString, listName, makefile);
-
-  makefile.AddDefinition(
-    listName, cmList::append(listString, args.begin() + 2, args.end()));
+  status.GetMakefile().AppendDefinition(
+    args[1], cmList::to_string(cmMakeRange(args).advance(2)),
+    cmList::element_separator);
   return true;
 }
 
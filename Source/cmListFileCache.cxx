@@ -3,6 +3,7 @@
 #define cmListFileCache_cxx
 #include "cmListFileCache.h"
 
+#include <cassert>
 #include <memory>
 #include <ostream>
 #include <utility>
@@ -12,6 +13,9 @@
 #endif
 
 #include <cm/string_view>
+#include <cmext/string_view>
+
+#include "cmsys/String.h"
 
 #include "cmDiagnostics.h"
 #include "cmList.h"
@@ -459,6 +463,103 @@ bool cmListFile::ParseString(cm::string_view str,
   return parser.ParseString(str);
 }
 
+namespace {
+
+bool IsVariableNameChar(char c)
+{
+  return cmsysString_isalnum(c) || c == '_' || c == '/' || c == '.' ||
+    c == '+' || c == '-';
+}
+
+std::shared_ptr<cmListFileArgumentPlan> BuildExpansionPlan(
+  cmListFileArgument const& arg)
+{
+  using Segment = cmListFileArgumentPlan::Segment;
+  auto plan = std::make_shared<cmListFileArgumentPlan>();
+  plan->ValueSize = arg.Value.size();
+  if (arg.Delim == cmListFileArgument::Bracket) {
+    plan->Kind = cmListFileArgumentPlan::Literal;
+    return plan;
+  }
+
+  cm::string_view const value = arg.Value;
+  std::string::size_type const end = value.size();
+  std::string::size_type last = 0;
+  std::string::size_type pos = 0;
+  while ((pos = value.find_first_of("$\\", pos)) != cm::string_view::npos) {
+    // Escape sequences are handled by the general expansion code.
+    if (value[pos] == '\\') {
+      return plan;
+    }
+
+    cm::string_view const next = value.substr(pos + 1);
+    Segment::SegmentKind kind;
+    std::string::size_type start;
+    if (cmHasPrefix(next, '{')) {
+      kind = Segment::Normal;
+      start = pos + 2;
+    } else if (cmHasLiteralPrefix(next, "ENV{")) {
+      kind = Segment::Environment;
+      start = pos + 5;
+    } else if (cmHasLiteralPrefix(next, "CACHE{")) {
+      kind = Segment::Cache;
+      start = pos + 7;
+    } else if (next.empty() || next.front() == '<') {
+      // A literal '$' or the start of a generator expression.
+      ++pos;
+      continue;
+    } else {
+      return plan;
+    }
+
+    // Only simple references whose name is followed directly by '}'
+    // can be replayed.  Nested references and invalid names are
+    // diagnosed by the general expansion code.
+    std::string::size_type close = start;
+    while (close < end && IsVariableNameChar(value[close])) {
+      ++close;
+    }
+    if (close == start || close == end || value[close] != '}') {
+      return plan;
+    }
+    cm::string_view const name = value.substr(start, close - start);
+    // The line of this variable depends on where in the argument it is.
+    if (kind == Segment::Normal && name == "CMAKE_CURRENT_LIST_LINE"_s) {
+      return plan;
+    }
+
+    if (pos > last) {
+      plan->Segments.push_back(
+        { Segment::Text, std::string(value.substr(last, pos - last)) });
+    }
+    plan->Segments.push_back({ kind, std::string(name) });
+    pos = last = close + 1;
+  }
+
+  if (plan->Segments.empty()) {
+    plan->Kind = cmListFileArgumentPlan::Literal;
+    return plan;
+  }
+  if (last < end) {
+    plan->Segments.push_back(
+      { Segment::Text, std::string(value.substr(last)) });
+  }
+  plan->Kind = cmListFileArgumentPlan::Template;
+  return plan;
+}
+
+}
+
+cmListFileArgumentPlan const& cmListFileArgument::GetExpansionPlan() const
+{
+  if (!this->Plan) {
+    this->Plan = BuildExpansionPlan(*this);
+  }
+  assert(this->Plan->ValueSize == this->Value.size() &&
+         "cmListFileArgument::Value modified after its plan was built");
+  return *this->Plan;
+}
+
 #include "cmConstStack.tcc"
 template class cmConstStack<cmListFileContext, cmListFileBacktrace>;
 
@@ -4,6 +4,8 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
+#include <functional>
 #include <iosfwd>
 #include <memory>
 #include <set>
@@ -25,8 +27,45 @@
  * cmake list files.
  */
 
+class cmExecutionStatus;
 class cmMakefile;
 
+/** \class cmListFileArgumentPlan
+ * \brief Pre-scanned form of a list file argument for variable expansion.
+ *
+ * Arguments consisting only of literal text and plain ${VAR}, $ENV{VAR},
+ * or $CACHE{VAR} references are split into segments once so that each
+ * execution can expand them without re-parsing the argument text.
+ * Anything else, e.g. escape sequences or nested references, is left to
+ * the general expansion code.
+ */
+struct cmListFileArgumentPlan
+{
+  enum PlanKind
+  {
+    Literal,
+    Template,
+    General
+  };
+  struct Segment
+  {
+    enum SegmentKind
+    {
+      Text,
+      Normal,
+      Environment,
+      Cache
+    };
+    SegmentKind Kind;
+    std::string Value;
+  };
+  PlanKind Kind = General;
+  std::vector<Segment> Segments;
+  // Size of the argument value the plan was built from, used to check
+  // in debug builds that the value has not changed since.
+  std::size_t ValueSize = 0;
+};
+
 struct cmListFileArgument
 {
   enum Delimiter
@@ -47,9 +86,17 @@ struct cmListFileArgument
     return (this->Value == r.Value) && (this->Delim == r.Delim);
   }
   bool operator!=(cmListFileArgument const& r) const { return !(*this == r); }
+
+  /** Get the expansion plan for this argument, building it on first use.
+      The Value must not be modified after this has been called.  */
+  cmListFileArgumentPlan const& GetExpansionPlan() const;
+
   std::string Value;
   Delimiter Delim = Unquoted;
   long Line = 0;
+
+private:
+  mutable std::shared_ptr<cmListFileArgumentPlan const> Plan;
 };
 
 class cmListFileFunction
@@ -80,6 +127,22 @@ public:
     return this->Impl->Arguments;
   }
 
+  using Command = std::function<bool(std::vector<cmListFileArgument> const&,
+                                     cmExecutionStatus&)>;
+
+  /** The command this call was last resolved to, along with the
+      cmState::GetCommandGeneration() value at the time of resolution.  */
+  struct ResolvedCommand
+  {
+    std::size_t Generation = 0;
+    Command Script;
+  };
+
+  ResolvedCommand& GetResolvedCommand() const noexcept
+  {
+    return this->Impl->Resolved;
+  }
+
 private:
   struct Implementation
   {
@@ -98,6 +161,7 @@ private:
     long Line = 0;
     long LineEnd = 0;
     std::vector<cmListFileArgument> Arguments;
+    mutable ResolvedCommand Resolved;
   };
 
   std::shared_ptr<Implementation const> Impl;
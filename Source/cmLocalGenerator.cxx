@@ -47,6 +47,7 @@
 #include "cmMakefile.h"
 #include "cmMessageType.h"
 #include "cmObjectLocation.h"
+#include "cmPathCache.h"
 #include "cmRange.h"
 #include "cmRulePlaceholderExpander.h"
 #include "cmScriptGenerator.h"
@@ -3312,6 +3313,159 @@ cmLocalGenerator::AddUnityFilesModeAuto(
   return unity_files;
 }
 
+namespace {
+// Parse a UNITY_COST property value.  Returns false if it is not a
+// non-negative number.
+bool unity_parse_cost(std::string const& value, double& cost)
+{
+  char* end = nullptr;
+  double const parsed = std::strtod(value.c_str(), &end);
+  if (end == value.c_str() || *end != '\0' || !(parsed >= 0)) {
+    return false;
+  }
+  cost = parsed;
+  return true;
+}
+
+// Get the backtrace of the call that added a source to a target.
+cmListFileBacktrace unity_source_backtrace(cmGeneratorTarget* target,
+                                           std::string const& config,
+                                           cmSourceFile* sf)
+{
+  for (BT<cmSourceFile*> const& source : target->GetSourceFiles(config)) {
+    if (source.Value == sf) {
+      return source.Backtrace;
+    }
+  }
+  return target->GetBacktrace();
+}
+
+// Get the size on disk of a source.  Returns a negative value if the
+// source does not exist yet.
+double unity_size_cost(cmSourceFile* sf)
+{
+  std::string const& path = sf->ResolveFullPath();
+  if (cmSystemTools::FileExists(path, true)) {
+    return static_cast<double>(cmSystemTools::FileLength(path));
+  }
+  return -1;
+}
+}
+
+std::vector<cmLocalGenerator::UnitySource>
+cmLocalGenerator::AddUnityFilesModeCost(
+  cmGeneratorTarget* target, std::string const& lang,
+  std::vector<std::string> const& configs,
+  std::vector<UnityBatchedSource> const& filtered_sources,
+  cmValue beforeInclude, cmValue afterInclude,
+  std::string const& filename_base, UnityPathMode pathMode, size_t batchSize)
+{
+  std::vector<UnitySource> unity_files;
+  if (filtered_sources.empty()) {
+    return unity_files;
+  }
+  if (batchSize == 0) {
+    batchSize = filtered_sources.size();
+  }
+
+  // UNITY_COST values and sizes on disk are not in the same units, so
+  // never mix them.  Use sizes only if no source sets UNITY_COST.
+  std::vector<double> costs;
+  costs.reserve(filtered_sources.size());
+  for (UnityBatchedSource const& ubs : filtered_sources) {
+    double cost = -1;
+    cmValue const value = ubs.Source->GetProperty("UNITY_COST");
+    if (value && !unity_parse_cost(*value, cost)) {
+      this->IssueMessage(
+        MessageType::WARNING,
+        cmStrCat("The UNITY_COST property of source\n  ",
+                 ubs.Source->ResolveFullPath(), "\nin target \"",
+                 target->GetName(), "\" has the value \"", *value,
+                 "\", which is not a non-negative number.  It is ignored."),
+        unity_source_backtrace(target, configs[ubs.Configs.front()],
+                               ubs.Source));
+    }
+    costs.push_back(cost);
+  }
+  if (std::none_of(costs.begin(), costs.end(),
+                   [](double cost) { return cost >= 0; })) {
+    for (size_t i = 0; i < filtered_sources.size(); ++i) {
+      costs[i] = unity_size_cost(filtered_sources[i].Source);
+    }
+  }
+
+  // Sources whose cost is not known are assumed to be average.
+  double known = 0;
+  size_t knownCount = 0;
+  for (double cost : costs) {
+    if (cost >= 0) {
+      known += cost;
+      ++knownCount;
+    }
+  }
+  double const average = knownCount > 0 ? known / knownCount : 1;
+  double total = 0;
+  for (double& cost : costs) {
+    if (cost < 0) {
+      cost = average;
+    }
+    total += cost;
+  }
+
+  // A source costing more than an average batch would dominate any batch
+  // it is placed in.  Leave it out so that it is compiled on its own.
+  size_t const batchCount =
+    (filtered_sources.size() + batchSize - 1) / batchSize;
+  double const batchCost = total / static_cast<double>(batchCount);
+  std::vector<size_t> batched;
+  for (size_t i = 0; i < filtered_sources.size(); ++i) {
+    if (filtered_sources.size() == 1 || costs[i] <= batchCost) {
+      batched.push_back(i);
+    }
+  }
+  if (batched.empty()) {
+    return unity_files;
+  }
+
+  // Assign the most expensive sources first, each to the batch with the
+  // lowest cost so far that still has room for it.
+  std::stable_sort(
+    batched.begin(), batched.end(),
+    [&costs](size_t l, size_t r) { return costs[l] > costs[r]; });
+  size_t const count = (batched.size() + batchSize - 1) / batchSize;
+  std::vector<double> loads(count, 0);
+  std::vector<std::vector<size_t>> members(count);
+  for (size_t i : batched) {
+    size_t best = count;
+    for (size_t b = 0; b < count; ++b) {
+      if (members[b].size() < batchSize &&
+          (best == count || loads[b] < loads[best])) {
+        best = b;
+      }
+    }
+    loads[best] += costs[i];
+    members[best].push_back(i);
+  }
+
+  // Keep the original source order within each batch.
+  char const* filename_prefix = unity_file_prefix(target);
+  for (size_t batch = 0; batch < count; ++batch) {
+    std::vector<size_t>& indices = members[batch];
+    std::sort(indices.begin(), indices.end());
+    std::vector<UnityBatchedSource> sources;
+    sources.reserve(indices.size());
+    for (size_t i : indices) {
+      sources.push_back(filtered_sources[i]);
+    }
+    std::string filename = cmStrCat(filename_base, filename_prefix, batch,
+                                    unity_file_extension(lang));
+    unity_files.emplace_back(this->WriteUnitySource(
+      target, configs, cmMakeRange(sources), beforeInclude, afterInclude,
+      std::move(filename), filename_base, pathMode));
+  }
+  return unity_files;
+}
+
 std::vector<cmLocalGenerator::UnitySource>
 cmLocalGenerator::AddUnityFilesModeGroup(
   cmGeneratorTarget* target, std::string const& lang,
@@ -3455,6 +3609,10 @@ void cmLocalGenerator::AddUnityBuild(cmGeneratorTarget* target)
       unity_files = AddUnityFilesModeAuto(
         target, lang, configs, filtered_sources, beforeInclude, afterInclude,
         filename_base, pathMode, unityBatchSize);
+    } else if (unityMode && *unityMode == "COST") {
+      unity_files = AddUnityFilesModeCost(
+        target, lang, configs, filtered_sources, beforeInclude, afterInclude,
+        filename_base, pathMode, unityBatchSize);
     } else if (unityMode && *unityMode == "GROUP") {
       unity_files = AddUnityFilesModeGroup(
         target, lang, configs, filtered_sources, beforeInclude, afterInclude,
@@ -3463,7 +3621,7 @@ void cmLocalGenerator::AddUnityBuild(cmGeneratorTarget* target)
       // unity mode is set to an unsupported value
       std::string e("Invalid UNITY_BUILD_MODE value of " + *unityMode +
                     " assigned to target " + target->GetName() +
-                    ". Acceptable values are BATCH and GROUP.");
+                    ". Acceptable values are BATCH, COST and GROUP.");
       this->IssueMessage(MessageType::FATAL_ERROR, e);
     }
 
@@ -5492,7 +5650,7 @@ std::vector<std::string> cmLocalGenerator::ExpandCustomCommandOutputPaths(
 {
   cmList paths{ cge.Evaluate(this, config) };
   for (std::string& p : paths) {
-    p = cmSystemTools::CollapseFullPath(p, this->GetCurrentBinaryDirectory());
+    p = cmPathCache::CollapseFullPath(p, this->GetCurrentBinaryDirectory());
   }
   return std::move(paths.data());
 }
@@ -2,10 +2,13 @@
    file LICENSE.rst or https://cmake.org/licensing for details.  */
 #include "cmMacroCommand.h"
 
+#include <cstddef>
 #include <functional>
+#include <memory>
 #include <utility>
 
 #include <cm/memory>
+#include <cm/optional>
 #include <cm/string_view>
 #include <cmext/algorithm>
 #include <cmext/string_view>
@@ -36,18 +39,66 @@ public:
   bool operator()(std::vector<cmListFileArgument> const& args,
                   cmExecutionStatus& inStatus) const;
 
-  std::vector<std::string> Args;
-  std::vector<cmListFileFunction> Functions;
-  cmPolicies::PolicyMap Policies;
-  cmDiagnostics::DiagnosticMap Diagnostics;
-  std::string FilePath;
+  // The command is copied each time it is invoked, so the recorded
+  // definition is shared between all copies and executed in place.
+  struct Definition
+  {
+    std::vector<std::string> Args;
+    // The ${<arg>} references to each formal argument.
+    std::vector<std::string> Variables;
+    std::vector<cmListFileFunction> Functions;
+    // For each function, the indices of its arguments that reference
+    // macro parameters.  Functions with none are invoked unchanged.
+    std::vector<std::vector<std::size_t>> Substitutions;
+    cmPolicies::PolicyMap Policies;
+    cmDiagnostics::DiagnosticMap Diagnostics;
+    std::string FilePath;
+  };
+  std::shared_ptr<Definition const> Def;
+
+  static std::vector<std::vector<std::size_t>> FindSubstitutions(
+    std::vector<std::string> const& variables,
+    std::vector<cmListFileFunction> const& functions);
 };
 
+std::vector<std::vector<std::size_t>> cmMacroHelperCommand::FindSubstitutions(
+  std::vector<std::string> const& variables,
+  std::vector<cmListFileFunction> const& functions)
+{
+  std::vector<std::string> references = variables;
+  references.emplace_back("${ARGC}");
+  references.emplace_back("${ARGN}");
+  // Matches both ${ARGV} and ${ARGV<n>}.
+  references.emplace_back("${ARGV");
+
+  std::vector<std::vector<std::size_t>> substitutions;
+  substitutions.reserve(functions.size());
+  for (cmListFileFunction const& func : functions) {
+    std::vector<std::size_t> indices;
+    std::vector<cmListFileArgument> const& funcArgs = func.Arguments();
+    for (std::size_t i = 0; i < funcArgs.size(); ++i) {
+      cmListFileArgument const& arg = funcArgs[i];
+      if (arg.Delim == cmListFileArgument::Bracket) {
+        continue;
+      }
+      for (std::string const& reference : references) {
+        if (arg.Value.find(reference) != std::string::npos) {
+          indices.push_back(i);
+          break;
+        }
+      }
+    }
+    substitutions.emplace_back(std::move(indices));
+  }
+  return substitutions;
+}
+
 bool cmMacroHelperCommand::operator()(
   std::vector<cmListFileArgument> const& args,
   cmExecutionStatus& inStatus) const
 {
   cmMakefile& makefile = inStatus.GetMakefile();
+  Definition const& def = *this->Def;
 
   // Expand the argument list to the macro.
   std::vector<std::string> expandedArgs;
@@ -55,10 +106,10 @@ bool cmMacroHelperCommand::operator()(
 
   // make sure the number of arguments passed is at least the number
   // required by the signature
-  if (expandedArgs.size() < this->Args.size() - 1) {
+  if (expandedArgs.size() < def.Args.size() - 1) {
     std::string errorMsg =
       cmStrCat("Macro invoked with incorrect arguments for macro named: ",
-               this->Args[0]);
+               def.Args[0]);
     inStatus.SetError(errorMsg);
     return false;
   }
@@ -66,13 +117,13 @@ bool cmMacroHelperCommand::operator()(
   // set the value of argc
   std::string argcDef = std::to_string(expandedArgs.size());
 
-  auto expIt = expandedArgs.begin() + (this->Args.size() - 1);
+  auto expIt = expandedArgs.begin() + (def.Args.size() - 1);
   std::string expandedArgn =
     cmList::to_string(cmMakeRange(expIt, expandedArgs.end()));
   std::string expandedArgv = cmList::to_string(expandedArgs);
   {
     cmPolicies::PolicyStatus cmp0219 =
-      makefile.CheckCMP0219(this->Args[0], expandedArgs);
+      makefile.CheckCMP0219(def.Args[0], expandedArgs);
     if (cmp0219 == cmPolicies::NEW) {
       // Escape macro argument backslashes so that callees receive the same
       // values the caller had.
@@ -82,62 +133,60 @@ bool cmMacroHelperCommand::operator()(
       cmSystemTools::ReplaceString(expandedArgn, "\\", "\\\\");
       cmSystemTools::ReplaceString(expandedArgv, "\\", "\\\\");
     } else if (cmp0219 == cmPolicies::WARN) {
-      makefile.IssueCMP0219Warning(this->Args[0], expandedArgs);
+      makefile.IssueCMP0219Warning(def.Args[0], expandedArgs);
     }
   }
-  std::vector<std::string> variables;
-  variables.reserve(this->Args.size() - 1);
-  for (unsigned int j = 1; j < this->Args.size(); ++j) {
-    variables.emplace_back(cmStrCat("${", this->Args[j], '}'));
-  }
+  std::vector<std::string> const& variables = def.Variables;
   std::vector<std::string> argVs;
   argVs.reserve(expandedArgs.size());
   for (unsigned int j = 0; j < expandedArgs.size(); ++j) {
     argVs.emplace_back(cmStrCat("${ARGV", j, '}'));
   }
 
-  cmMakefile::MacroPushPop macroScope(&makefile, this->FilePath,
-                                      this->Policies, this->Diagnostics);
+  cmMakefile::MacroPushPop macroScope(&makefile, def.FilePath,
+                                      def.Policies, def.Diagnostics);
 
   // Invoke all the functions that were collected in the block.
   // for each function
-  for (cmListFileFunction const& func : this->Functions) {
+  for (std::size_t i = 0; i < def.Functions.size(); ++i) {
+    cmListFileFunction const& func = def.Functions[i];
+    std::vector<std::size_t> const& substitutions = def.Substitutions[i];
+
     // Replace the formal arguments and then invoke the command.
-    std::vector<cmListFileArgument> newLFFArgs;
-    newLFFArgs.reserve(func.Arguments().size());
-
-    // for each argument of the current function
-    for (cmListFileArgument const& k : func.Arguments()) {
-      cmListFileArgument arg;
-      arg.Value = k.Value;
-      if (k.Delim != cmListFileArgument::Bracket) {
+    // Functions that do not reference them are invoked as recorded.
+    cm::optional<cmListFileFunction> newLFF;
+    if (!substitutions.empty()) {
+      std::vector<cmListFileArgument> newLFFArgs = func.Arguments();
+
+      // for each argument of the current function that needs it
+      for (std::size_t const index : substitutions) {
+        cmListFileArgument const& k = func.Arguments()[index];
+        std::string value = k.Value;
         // replace formal arguments
         for (unsigned int j = 0; j < variables.size(); ++j) {
-          cmSystemTools::ReplaceString(arg.Value, variables[j],
-                                       expandedArgs[j]);
+          cmSystemTools::ReplaceString(value, variables[j], expandedArgs[j]);
         }
         // replace argc
-        cmSystemTools::ReplaceString(arg.Value, "${ARGC}", argcDef);
+        cmSystemTools::ReplaceString(value, "${ARGC}", argcDef);
 
-        cmSystemTools::ReplaceString(arg.Value, "${ARGN}", expandedArgn);
-        cmSystemTools::ReplaceString(arg.Value, "${ARGV}", expandedArgv);
+        cmSystemTools::ReplaceString(value, "${ARGN}", expandedArgn);
+        cmSystemTools::ReplaceString(value, "${ARGV}", expandedArgv);
 
         // if the current argument of the current function has ${ARGV in it
         // then try replacing ARGV values
-        if (arg.Value.find("${ARGV") != std::string::npos) {
+        if (value.find("${ARGV") != std::string::npos) {
           for (unsigned int t = 0; t < expandedArgs.size(); ++t) {
-            cmSystemTools::ReplaceString(arg.Value, argVs[t], expandedArgs[t]);
+            cmSystemTools::ReplaceString(value, argVs[t], expandedArgs[t]);
           }
         }
+        newLFFArgs[index] = cmListFileArgument(value, k.Delim, k.Line);
       }
-      arg.Delim = k.Delim;
-      arg.Line = k.Line;
-      newLFFArgs.push_back(std::move(arg));
+      newLFF.emplace(func.OriginalName(), func.Line(), func.LineEnd(),
+                     std::move(newLFFArgs));
     }
-    cmListFileFunction newLFF{ func.OriginalName(), func.Line(),
-                               func.LineEnd(), std::move(newLFFArgs) };
     cmExecutionStatus status(makefile);
-    if (!makefile.ExecuteCommand(newLFF, status) || status.GetNestedError()) {
+    if (!makefile.ExecuteCommand(newLFF ? *newLFF : func, status) ||
+        status.GetNestedError()) {
       // The error message should have already included the call stack
       // so we do not need to report an error here.
       macroScope.Quiet();
@@ -197,12 +246,20 @@ bool cmMacroFunctionBlocker::Replay(std::vector<cmListFileFunction> functions,
     mf.AppendProperty("MACROS", this->Args[0]);
   }
   // create a new command and add it to cmake
+  auto def = std::make_shared<cmMacroHelperCommand::Definition>();
+  def->Args = this->Args;
+  def->Variables.reserve(this->Args.size() - 1);
+  for (unsigned int j = 1; j < this->Args.size(); ++j) {
+    def->Variables.emplace_back(cmStrCat("${", this->Args[j], '}'));
+  }
+  def->Substitutions =
+    cmMacroHelperCommand::FindSubstitutions(def->Variables, functions);
+  def->Functions = std::move(functions);
+  def->FilePath = this->GetStartingContext().FilePath;
+  mf.RecordPolicies(def->Policies);
+  mf.RecordDiagnostics(def->Diagnostics);
   cmMacroHelperCommand f;
-  f.Args = this->Args;
-  f.Functions = std::move(functions);
-  f.FilePath = this->GetStartingContext().FilePath;
-  mf.RecordPolicies(f.Policies);
-  mf.RecordDiagnostics(f.Diagnostics);
+  f.Def = std::move(def);
   return mf.GetState()->AddScriptedCommand(
     this->Args[0], cmStateEnums::CommandType::Macro,
     BT<cmState::Command>(std::move(f),
@@ -23,7 +23,6 @@
 
 #ifndef CMAKE_BOOTSTRAP
 #  include <cm3p/json/value.h>
-#  include <cm3p/json/writer.h>
 #endif
 
 #include "cmsys/FStream.hxx"
@@ -64,6 +63,7 @@
 #include "cmTargetLinkLibraryType.h"
 #include "cmTest.h"
 #include "cmTestGenerator.h" // IWYU pragma: keep
+#include "cmTraceRecord.h"
 #include "cmVersion.h"
 #include "cmWorkingDirectory.h"
 #include "cmake.h"
@@ -382,95 +382,65 @@ void cmMakefile::PrintCommandTrace(cmListFileFunction const& lff,
                                    CommandMissingFromStack missing) const
 {
   // Check if current file in the list of requested to trace...
-  std::vector<std::string> const& trace_only_this_files =
-    this->GetCMakeInstance()->GetTraceSources();
+  cmake* cm = this->GetCMakeInstance();
   std::string const& full_path = bt.Top().FilePath;
-  cm::string_view only_filename =
-    cmSystemTools::GetFilenameNameView(full_path);
-  bool trace = trace_only_this_files.empty();
-  if (!trace) {
-    for (std::string const& file : trace_only_this_files) {
-      std::string::size_type const pos = full_path.rfind(file);
-      trace = (pos != std::string::npos) &&
-        ((pos + file.size()) == full_path.size()) &&
-        (only_filename == cmSystemTools::GetFilenameNameView(file));
-      if (trace) {
-        break;
-      }
-    }
-    // Do nothing if current file wasn't requested for trace...
-    if (!trace) {
-      return;
-    }
+  if (!cmTraceRecord::MatchesSource(full_path, cm->GetTraceSources())) {
+    return;
   }
 
-  std::vector<std::string> args;
-  std::string temp;
-  bool expand = this->GetCMakeInstance()->GetTraceExpand();
+  cmTraceRecord record;
+  record.File = full_path;
+  record.Line = lff.Line();
+  record.LineEnd = lff.LineEnd();
+  record.DeferId = bt.Top().DeferId;
+  record.Command = lff.OriginalName();
 
-  args.reserve(lff.Arguments().size());
+  bool expand = cm->GetTraceExpand();
+  record.Args.reserve(lff.Arguments().size());
   for (cmListFileArgument const& arg : lff.Arguments()) {
     if (expand && arg.Delim != cmListFileArgument::Bracket) {
-      temp = arg.Value;
+      std::string temp = arg.Value;
       this->ExpandVariablesInString(temp);
-      args.push_back(temp);
+      record.Args.emplace_back(std::move(temp));
     } else {
-      args.push_back(arg.Value);
+      record.Args.push_back(arg.Value);
     }
   }
-  cm::optional<std::string> const& deferId = bt.Top().DeferId;
 
-  std::ostringstream msg;
-  switch (this->GetCMakeInstance()->GetTraceFormat()) {
-    case cmake::TraceFormat::JSONv1: {
+  cmake::TraceFormat const format = cm->GetTraceFormat();
+  if (format != cmake::TraceFormat::Human) {
+    record.Time = cmSystemTools::GetTime();
+    record.Frame = int(missing == CommandMissingFromStack::Yes) +
+      this->ExecutionStatusStack.size();
+    record.GlobalFrame =
+      int(missing == CommandMissingFromStack::Yes) + this->RecursionDepth;
+  }
+
+  std::string msg;
+  switch (format) {
+    case cmake::TraceFormat::JSONv1:
 #ifndef CMAKE_BOOTSTRAP
-      Json::Value val;
-      Json::StreamWriterBuilder builder;
-      builder["indentation"] = "";
-      val["file"] = full_path;
-      val["line"] = static_cast<Json::Value::Int64>(lff.Line());
-      if (lff.Line() != lff.LineEnd()) {
-        val["line_end"] = static_cast<Json::Value::Int64>(lff.LineEnd());
-      }
-      if (deferId) {
-        val["defer"] = *deferId;
-      }
-      val["cmd"] = lff.OriginalName();
-      val["args"] = Json::Value(Json::arrayValue);
-      for (std::string const& arg : args) {
-        val["args"].append(arg);
-      }
-      val["time"] = cmSystemTools::GetTime();
-      val["frame"] = int(missing == CommandMissingFromStack::Yes) +
-        static_cast<Json::Value::UInt64>(this->ExecutionStatusStack.size());
-      val["global_frame"] = int(missing == CommandMissingFromStack::Yes) +
-        static_cast<Json::Value::UInt64>(this->RecursionDepth);
-      msg << Json::writeString(builder, val);
+      msg = record.ToJSON();
 #endif
       break;
-    }
-    case cmake::TraceFormat::Human:
-      msg << full_path << '(' << lff.Line() << "):";
-      if (deferId) {
-        msg << "DEFERRED:" << *deferId << ':';
+    case cmake::TraceFormat::BinaryV1:
+      if (cmBinaryTraceWriter* writer = cm->GetBinaryTraceWriter()) {
+        writer->Write(record);
       }
-      msg << "  " << lff.OriginalName() << '(';
-
-      for (std::string const& arg : args) {
-        msg << arg << ' ';
-      }
-      msg << ')';
+      return;
+    case cmake::TraceFormat::Human:
+      msg = record.ToHuman();
       break;
     case cmake::TraceFormat::Undefined:
-      msg << "INTERNAL ERROR: Trace format is Undefined";
+      msg = "INTERNAL ERROR: Trace format is Undefined";
       break;
   }
 
-  auto& f = this->GetCMakeInstance()->GetTraceFile();
+  auto& f = cm->GetTraceFile();
   if (f) {
-    f << msg.str() << '\n';
+    f << msg << '\n';
   } else {
-    cmSystemTools::Message(msg.str());
+    cmSystemTools::Message(msg);
   }
 }
 
@@ -607,9 +577,17 @@ bool cmMakefile::ExecuteCommand(cmListFileFunction const& lff,
     return false;
   }
 
-  // Lookup the command prototype.
-  if (cmState::Command command =
-        this->GetState()->GetCommandByExactName(lff.LowerCaseName())) {
+  // Lookup the command prototype.  The result is cached on the function
+  // call until the set of commands changes.
+  cmListFileFunction::ResolvedCommand& resolved = lff.GetResolvedCommand();
+  std::size_t const generation = this->GetState()->GetCommandGeneration();
+  if (resolved.Generation != generation) {
+    resolved.Script =
+      this->GetState()->GetCommandByExactName(lff.LowerCaseName());
+    resolved.Generation = generation;
+  }
+  // Invoke a copy in case the command replaces itself while running.
+  if (cmState::Command command = resolved.Script) {
     // Decide whether to invoke the command.
     if (!cmSystemTools::GetFatalErrorOccurred()) {
       // if trace is enabled, print out invoke information
@@ -1918,6 +1896,32 @@ void cmMakefile::AddDefinition(std::string const& name, cm::string_view value)
 #endif
 }
 
+void cmMakefile::AppendDefinition(std::string const& name,
+                                  cm::string_view value,
+                                  cm::string_view separator)
+{
+  // Values from the cache and watched variables need the full
+  // read-modify-write sequence.
+  bool const watched =
+#ifndef CMAKE_BOOTSTRAP
+    this->GetVariableWatch() &&
+    this->GetVariableWatch()->IsWatched(name);
+#else
+    false;
+#endif
+  if (watched || !this->StateSnapshot.GetDefinition(name)) {
+    std::string newValue = this->GetSafeDefinition(name);
+    if (!newValue.empty()) {
+      newValue.append(separator.data(), separator.size());
+    }
+    newValue.append(value.data(), value.size());
+    this->AddDefinition(name, newValue);
+    return;
+  }
+
+  this->StateSnapshot.AppendDefinition(name, value, separator);
+}
+
 void cmMakefile::AddDefinitionBool(std::string const& name, bool value)
 {
   this->AddDefinition(name, value ? "ON" : "OFF");
@@ -3092,6 +3096,53 @@ bool cmMakefile::IsLoopBlock() const
   return !this->LoopBlockCounter.empty() && this->LoopBlockCounter.top() > 0;
 }
 
+std::string const& cmMakefile::ExpandArgument(cmListFileArgument const& arg,
+                                              std::string const& filename,
+                                              std::string& value) const
+{
+  cmListFileArgumentPlan const& plan = arg.GetExpansionPlan();
+  switch (plan.Kind) {
+    case cmListFileArgumentPlan::Literal:
+      return arg.Value;
+    case cmListFileArgumentPlan::Template:
+      break;
+    case cmListFileArgumentPlan::General:
+      value = arg.Value;
+      return this->ExpandVariablesInString(value, false, false, false,
+                                           filename.c_str(), arg.Line, false,
+                                           false);
+  }
+
+  using Segment = cmListFileArgumentPlan::Segment;
+  std::string svalue;
+  value.clear();
+  for (Segment const& segment : plan.Segments) {
+    cmValue def;
+    switch (segment.Kind) {
+      case Segment::Text:
+        value += segment.Value;
+        continue;
+      case Segment::Normal:
+        def = this->GetDefinition(segment.Value);
+        break;
+      case Segment::Environment:
+        if (cmSystemTools::GetEnv(segment.Value, svalue)) {
+          def = cmValue(svalue);
+        }
+        break;
+      case Segment::Cache:
+        def = this->GetState()->GetCacheEntryValue(segment.Value);
+        break;
+    }
+    if (def) {
+      value += *def;
+    } else {
+      this->MaybeWarnUninitialized(segment.Value, filename.c_str());
+    }
+  }
+  return value;
+}
+
 bool cmMakefile::ExpandArguments(std::vector<cmListFileArgument> const& inArgs,
                                  std::vector<std::string>& outArgs) const
 {
@@ -3105,16 +3156,14 @@ bool cmMakefile::ExpandArguments(std::vector<cmListFileArgument> const& inArgs,
       continue;
     }
     // Expand the variables in the argument.
-    value = i.Value;
-    this->ExpandVariablesInString(value, false, false, false, filename.c_str(),
-                                  i.Line, false, false);
+    std::string const& expanded = this->ExpandArgument(i, filename, value);
 
     // If the argument is quoted, it should be one argument.
     // Otherwise, it may be a list of arguments.
     if (i.Delim == cmListFileArgument::Quoted) {
-      outArgs.push_back(value);
+      outArgs.push_back(expanded);
     } else {
-      cmExpandList(value, outArgs);
+      cmExpandList(expanded, outArgs);
     }
   }
   return !cmSystemTools::GetFatalErrorOccurred();
@@ -3134,16 +3183,14 @@ bool cmMakefile::ExpandArguments(
       continue;
     }
     // Expand the variables in the argument.
-    value = i.Value;
-    this->ExpandVariablesInString(value, false, false, false, filename.c_str(),
-                                  i.Line, false, false);
+    std::string const& expanded = this->ExpandArgument(i, filename, value);
 
     // If the argument is quoted, it should be one argument.
     // Otherwise, it may be a list of arguments.
     if (i.Delim == cmListFileArgument::Quoted) {
-      outArgs.emplace_back(value, true);
+      outArgs.emplace_back(expanded, true);
     } else {
-      cmList stringArgs{ value };
+      cmList stringArgs{ expanded };
       for (std::string const& stringArg : stringArgs) {
         outArgs.emplace_back(stringArg, false);
       }
@@ -333,6 +333,15 @@ public:
   {
     this->AddDefinition(name, *value);
   }
+  /**
+   * Append to a variable definition, inserting 'separator' first if the
+   * existing value is not empty.  This is equivalent to reading the
+   * variable and setting it to the result, but repeated appends to a
+   * variable defined in this scope take amortized constant time.
+   */
+  void AppendDefinition(std::string const& name, cm::string_view value,
+                        cm::string_view separator);
+
   /**
    * Add bool variable definition to the build.
    */
@@ -1344,6 +1353,10 @@ private:
   class BuildsystemFileScope;
   friend class BuildsystemFileScope;
 
+  std::string const& ExpandArgument(cmListFileArgument const& arg,
+                                    std::string const& filename,
+                                    std::string& value) const;
+
   MessageType ExpandVariablesInStringImpl(std::string& errorstr,
                                           std::string& source,
                                           bool escapeQuotes, bool noEscapes,
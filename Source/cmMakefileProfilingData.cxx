@@ -12,6 +12,9 @@
 #include "cmsys/FStream.hxx"
 #include "cmsys/SystemInformation.hxx"
 
+#include "cmGeneratedFileStream.h"
+#include "cmPathCache.h"
+#include "cmRegexCache.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 
@@ -34,6 +37,7 @@ cmMakefileProfilingData::~cmMakefileProfilingData() noexcept
 {
   if (this->ProfileStream.good()) {
     try {
+      this->WriteCounters();
       this->ProfileStream << "]";
       this->ProfileStream.close();
     } catch (...) {
@@ -42,6 +46,53 @@ cmMakefileProfilingData::~cmMakefileProfilingData() noexcept
   }
 }
 
+void cmMakefileProfilingData::WriteCounters()
+{
+  cmRegexCache::Statistics const regexStats = cmRegexCache::GetStatistics();
+  Json::Value regexArgs = Json::objectValue;
+  regexArgs["hits"] = static_cast<Json::Value::UInt64>(regexStats.Hits);
+  regexArgs["misses"] = static_cast<Json::Value::UInt64>(regexStats.Misses);
+  regexArgs["size"] = static_cast<Json::Value::UInt64>(regexStats.Size);
+  this->WriteCounter("regex cache", std::move(regexArgs));
+
+  cmPathCache::Statistics const pathStats = cmPathCache::GetStatistics();
+  Json::Value pathArgs = Json::objectValue;
+  pathArgs["hits"] = static_cast<Json::Value::UInt64>(pathStats.Hits);
+  pathArgs["misses"] = static_cast<Json::Value::UInt64>(pathStats.Misses);
+  this->WriteCounter("path cache", std::move(pathArgs));
+
+  cmGeneratedFileStream::Statistics const fileStats =
+    cmGeneratedFileStream::GetStatistics();
+  Json::Value fileArgs = Json::objectValue;
+  fileArgs["written"] = static_cast<Json::Value::UInt64>(fileStats.Written);
+  fileArgs["unchanged"] =
+    static_cast<Json::Value::UInt64>(fileStats.Unchanged);
+  fileArgs["unchangedBytes"] =
+    static_cast<Json::Value::UInt64>(fileStats.UnchangedBytes);
+  this->WriteCounter("generated files", std::move(fileArgs));
+}
+
+void cmMakefileProfilingData::WriteCounter(std::string const& name,
+                                           Json::Value args)
+{
+  if (this->ProfileStream.tellp() > 1) {
+    this->ProfileStream << ",";
+  }
+  cmsys::SystemInformation info;
+  Json::Value v;
+  v["ph"] = "C";
+  v["name"] = name;
+  v["cat"] = "cmake";
+  v["ts"] = static_cast<Json::Value::UInt64>(
+    std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch())
+      .count());
+  v["pid"] = static_cast<int>(info.GetProcessId());
+  v["tid"] = 0;
+  v["args"] = std::move(args);
+  this->JsonWriter->write(v, &this->ProfileStream);
+}
+
 void cmMakefileProfilingData::StartEntry(std::string const& category,
                                          std::string const& name,
                                          cm::optional<Json::Value> args)
@@ -44,6 +44,10 @@ public:
   };
 
 private:
+  // Write counters accumulated over the whole run.
+  void WriteCounters();
+  void WriteCounter(std::string const& name, Json::Value args);
+
   cmsys::ofstream ProfileStream;
   std::unique_ptr<Json::StreamWriter> JsonWriter;
 };
@@ -0,0 +1,319 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmMemoryReport.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <cm3p/json/writer.h>
+
+#include "cmsys/FStream.hxx"
+
+#include "cmAlgorithms.h"
+#include "cmGlobalGenerator.h"
+#include "cmListFileCache.h"
+#include "cmMakefile.h"
+#include "cmPropertyMap.h"
+#include "cmSourceFile.h"
+#include "cmSourceFileLocation.h"
+#include "cmState.h"
+#include "cmStateDirectory.h"
+#include "cmStateSnapshot.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+#include "cmTarget.h"
+#include "cmValue.h"
+#include "cmake.h"
+
+namespace {
+// Number of directories and targets listed individually.
+std::size_t const TopCount = 10;
+
+// Estimated size of a shared_ptr control block and heap node overhead.
+std::size_t const NodeOverhead = 2 * sizeof(void*);
+
+// Bytes a string holds outside of its own object.
+std::size_t HeapBytes(std::string const& s)
+{
+  char const* object = reinterpret_cast<char const*>(&s);
+  if (s.data() >= object && s.data() < object + sizeof(s)) {
+    return 0;
+  }
+  return s.capacity() + 1;
+}
+
+std::size_t StringBytes(std::string const& s)
+{
+  return sizeof(s) + HeapBytes(s);
+}
+
+struct Category
+{
+  std::size_t Count = 0;
+  std::size_t Bytes = 0;
+
+  void Add(std::size_t bytes)
+  {
+    ++this->Count;
+    this->Bytes += bytes;
+  }
+
+  Json::Value Dump() const
+  {
+    Json::Value value = Json::objectValue;
+    value["count"] = static_cast<Json::UInt64>(this->Count);
+    value["bytes"] = static_cast<Json::UInt64>(this->Bytes);
+    return value;
+  }
+};
+
+struct Entry
+{
+  Json::Value Value;
+  std::size_t Bytes;
+};
+
+class Walker
+{
+public:
+  Json::Value Run(cmGlobalGenerator const& gg);
+
+private:
+  std::size_t AddBacktrace(cmListFileBacktrace bt);
+  std::size_t AddTarget(cmTarget const& target);
+  std::size_t AddSourceFile(cmSourceFile const& sf);
+  std::size_t AddVariables(cmStateSnapshot const& snapshot,
+                           std::size_t& count);
+  void AddDirectory(cmMakefile const& mf);
+  void AddCacheEntries(cmState& state);
+
+  static Json::Value Largest(std::vector<Entry>& entries);
+
+  Category Directories;
+  Category Targets;
+  Category SourceFiles;
+  Category Variables;
+  Category CacheEntries;
+  Category Backtraces;
+  std::unordered_set<cmListFileContext const*> SeenFrames;
+  std::unordered_set<std::string const*> SeenValues;
+  std::vector<Entry> DirectoryEntries;
+  std::vector<Entry> TargetEntries;
+};
+
+std::size_t Walker::AddBacktrace(cmListFileBacktrace bt)
+{
+  // Backtraces share their frames, so count each frame once.
+  std::size_t bytes = 0;
+  while (!bt.Empty()) {
+    cmListFileContext const& top = bt.Top();
+    if (!this->SeenFrames.insert(&top).second) {
+      break;
+    }
+    std::size_t frameBytes = sizeof(top) + NodeOverhead +
+      HeapBytes(top.Name) + HeapBytes(top.FilePath);
+    if (top.DeferId) {
+      frameBytes += HeapBytes(*top.DeferId);
+    }
+    this->Backtraces.Add(frameBytes);
+    bytes += frameBytes;
+    bt = bt.Pop();
+  }
+  return bytes;
+}
+
+std::size_t Walker::AddTarget(cmTarget const& target)
+{
+  std::size_t bytes = sizeof(target) + HeapBytes(target.GetName()) +
+    target.GetDirectProperties().GetMemoryUsage();
+  this->AddBacktrace(target.GetBacktrace());
+
+  cmBTStringRange const ranges[] = {
+    target.GetIncludeDirectoriesEntries(),
+    target.GetCompileOptionsEntries(),
+    target.GetCompileFeaturesEntries(),
+    target.GetCompileDefinitionsEntries(),
+    target.GetPrecompileHeadersEntries(),
+    target.GetSourceEntries(),
+    target.GetLinkOptionsEntries(),
+    target.GetLinkDirectoriesEntries(),
+    target.GetLinkImplementationEntries(),
+    target.GetLinkInterfaceEntries(),
+    target.GetLinkInterfaceDirectEntries(),
+    target.GetLinkInterfaceDirectExcludeEntries(),
+  };
+  for (cmBTStringRange const& range : ranges) {
+    for (BT<std::string> const& entry : range) {
+      bytes += sizeof(entry) + HeapBytes(entry.Value);
+      this->AddBacktrace(entry.Backtrace);
+    }
+  }
+
+  this->Targets.Add(bytes);
+  Json::Value value = Json::objectValue;
+  value["name"] = target.GetName();
+  value["directory"] = target.GetMakefile()->GetCurrentSourceDirectory();
+  value["bytes"] = static_cast<Json::UInt64>(bytes);
+  this->TargetEntries.push_back({ std::move(value), bytes });
+  return bytes;
+}
+
+std::size_t Walker::AddSourceFile(cmSourceFile const& sf)
+{
+  cmSourceFileLocation const& location = sf.GetLocation();
+  std::size_t const bytes = sizeof(sf) + sizeof(location) +
+    HeapBytes(sf.GetFullPath()) + HeapBytes(location.GetDirectory()) +
+    HeapBytes(location.GetName()) + sf.GetProperties().GetMemoryUsage();
+  this->SourceFiles.Add(bytes);
+  return bytes;
+}
+
+std::size_t Walker::AddVariables(cmStateSnapshot const& snapshot,
+                                 std::size_t& count)
+{
+  // Directories and scopes share the values they inherit, so count
+  // each value once even though it is visible in many directories.
+  std::size_t bytes = 0;
+  for (std::string const& key : snapshot.ClosureKeys()) {
+    ++count;
+    cmValue value = snapshot.GetDefinition(key);
+    if (value && !this->SeenValues.insert(value.Get()).second) {
+      continue;
+    }
+    std::size_t varBytes = NodeOverhead + key.size() + 1;
+    if (value) {
+      varBytes += StringBytes(*value);
+    }
+    this->Variables.Add(varBytes);
+    bytes += varBytes;
+  }
+  return bytes;
+}
+
+void Walker::AddDirectory(cmMakefile const& mf)
+{
+  std::size_t bytes = sizeof(mf);
+
+  cmStateSnapshot const snapshot = mf.GetStateSnapshot();
+  cmStateDirectory const dir = snapshot.GetDirectory();
+  for (std::string const& key : dir.GetPropertyKeys()) {
+    bytes += StringBytes(key);
+    if (cmValue value = dir.GetProperty(key)) {
+      bytes += StringBytes(*value);
+    }
+  }
+  this->Directories.Add(bytes);
+
+  std::size_t variables = 0;
+  bytes += this->AddVariables(snapshot, variables);
+
+  std::size_t targets = 0;
+  for (auto const& target : mf.GetTargets()) {
+    bytes += this->AddTarget(target.second);
+    ++targets;
+  }
+  for (auto const& target : mf.GetOwnedImportedTargets()) {
+    bytes += this->AddTarget(*target);
+    ++targets;
+  }
+
+  std::size_t sources = 0;
+  for (auto const& sf : mf.GetSourceFiles()) {
+    bytes += this->AddSourceFile(*sf);
+    ++sources;
+  }
+
+  Json::Value value = Json::objectValue;
+  value["source"] = mf.GetCurrentSourceDirectory();
+  value["bytes"] = static_cast<Json::UInt64>(bytes);
+  value["targets"] = static_cast<Json::UInt64>(targets);
+  value["sourceFiles"] = static_cast<Json::UInt64>(sources);
+  value["variables"] = static_cast<Json::UInt64>(variables);
+  this->DirectoryEntries.push_back({ std::move(value), bytes });
+}
+
+void Walker::AddCacheEntries(cmState& state)
+{
+  for (std::string const& key : state.GetCacheEntryKeys()) {
+    std::size_t bytes = NodeOverhead + StringBytes(key);
+    if (cmValue value = state.GetCacheEntryValue(key)) {
+      bytes += StringBytes(*value);
+    }
+    for (std::string const& prop : state.GetCacheEntryPropertyList(key)) {
+      bytes += StringBytes(prop);
+      if (cmValue value = state.GetCacheEntryProperty(key, prop)) {
+        bytes += StringBytes(*value);
+      }
+    }
+    this->CacheEntries.Add(bytes);
+  }
+}
+
+Json::Value Walker::Largest(std::vector<Entry>& entries)
+{
+  std::size_t const n = std::min(entries.size(), TopCount);
+  std::partial_sort(
+    entries.begin(), entries.begin() + n, entries.end(),
+    [](Entry const& l, Entry const& r) { return l.Bytes > r.Bytes; });
+  Json::Value list = Json::arrayValue;
+  for (std::size_t i = 0; i < n; ++i) {
+    list.append(std::move(entries[i].Value));
+  }
+  return list;
+}
+
+Json::Value Walker::Run(cmGlobalGenerator const& gg)
+{
+  for (auto const& mf : gg.GetMakefiles()) {
+    this->AddDirectory(*mf);
+  }
+  this->AddCacheEntries(*gg.GetCMakeInstance()->GetState());
+
+  Json::Value categories = Json::objectValue;
+  categories["directories"] = this->Directories.Dump();
+  categories["targets"] = this->Targets.Dump();
+  categories["sourceFiles"] = this->SourceFiles.Dump();
+  categories["variables"] = this->Variables.Dump();
+  categories["cacheEntries"] = this->CacheEntries.Dump();
+  categories["backtraces"] = this->Backtraces.Dump();
+
+  Json::Value phase = Json::objectValue;
+  phase["categories"] = std::move(categories);
+  phase["largestDirectories"] = Largest(this->DirectoryEntries);
+  phase["largestTargets"] = Largest(this->TargetEntries);
+  return phase;
+}
+}
+
+cmMemoryReport::cmMemoryReport(std::string file)
+  : File(std::move(file))
+  , Root(Json::objectValue)
+{
+  Json::Value version = Json::objectValue;
+  version["major"] = 1;
+  version["minor"] = 0;
+  this->Root["version"] = std::move(version);
+}
+
+bool cmMemoryReport::WritePhase(std::string const& phase,
+                                cmGlobalGenerator const& gg)
+{
+  this->Root[phase] = Walker().Run(gg);
+
+  cmsys::ofstream fout(this->File.c_str());
+  if (!fout) {
+    cmSystemTools::Error(
+      cmStrCat("Could not write memory report ", this->File));
+    return false;
+  }
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "  ";
+  std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+  writer->write(this->Root, &fout);
+  fout << '\n';
+  return true;
+}
@@ -0,0 +1,33 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <string>
+
+#include <cm3p/json/value.h>
+
+class cmGlobalGenerator;
+
+/** \class cmMemoryReport
+ * \brief Write the --memory-report file.
+ *
+ * After configure and after generate, walk the directories, targets,
+ * source files, variables, cache entries and backtraces held by the
+ * project and record estimated sizes and object counts per category,
+ * along with the largest directories and targets.  Sizes are computed
+ * from the contents of each object rather than measured from the heap.
+ */
+class cmMemoryReport
+{
+public:
+  cmMemoryReport(std::string file);
+
+  /** Add a report for the given phase and rewrite the report file.  */
+  bool WritePhase(std::string const& phase, cmGlobalGenerator const& gg);
+
+private:
+  std::string File;
+  Json::Value Root;
+};
@@ -46,6 +46,7 @@
 #include "cmNinjaNormalTargetGenerator.h"
 #include "cmNinjaUtilityTargetGenerator.h"
 #include "cmOutputConverter.h"
+#include "cmPathCache.h"
 #include "cmPolicies.h"
 #include "cmRange.h"
 #include "cmRulePlaceholderExpander.h"
@@ -2591,10 +2592,10 @@ void cmNinjaTargetGenerator::ExportObjectCompileCommand(
 
   if (!cmSystemTools::FileIsFullPath(sourceFileName)) {
     escapedSourceFileName =
-      cmSystemTools::CollapseFullPath(escapedSourceFileName,
-                                      this->GetGlobalGenerator()
-                                        ->GetCMakeInstance()
-                                        ->GetHomeOutputDirectory());
+      cmPathCache::CollapseFullPath(escapedSourceFileName,
+                                    this->GetGlobalGenerator()
+                                      ->GetCMakeInstance()
+                                      ->GetHomeOutputDirectory());
   }
 
   escapedSourceFileName = this->LocalGenerator->ConvertToOutputFormat(
@@ -2699,10 +2700,10 @@ void cmNinjaTargetGenerator::ExportSwiftObjectCompileCommand(
   auto escapeSourceFileName = [this](std::string srcFilename) -> std::string {
     if (!cmSystemTools::FileIsFullPath(srcFilename)) {
       srcFilename =
-        cmSystemTools::CollapseFullPath(srcFilename,
-                                        this->GetGlobalGenerator()
-                                          ->GetCMakeInstance()
-                                          ->GetHomeOutputDirectory());
+        cmPathCache::CollapseFullPath(srcFilename,
+                                      this->GetGlobalGenerator()
+                                        ->GetCMakeInstance()
+                                        ->GetHomeOutputDirectory());
     }
 
     return this->LocalGenerator->ConvertToOutputFormat(
@@ -4,7 +4,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <functional>
+#include <numeric>
 #include <sstream>
 #include <vector>
 
@@ -63,7 +65,7 @@ public:
 
   void FindConflicts(unsigned int index)
   {
-    for (unsigned int i = 0; i < this->OD->OriginalDirectories.size(); ++i) {
+    for (unsigned int i : this->FindCandidateDirectories()) {
       // Check if this directory conflicts with the entry.
       std::string const& dir = this->OD->OriginalDirectories[i];
       if (!this->OD->IsSameDirectory(dir, this->Directory) &&
@@ -80,8 +82,9 @@ public:
   void FindImplicitConflicts(std::ostringstream& w)
   {
     bool first = true;
-    for (std::string const& dir : this->OD->OriginalDirectories) {
+    for (unsigned int i : this->FindCandidateDirectories()) {
       // Check if this directory conflicts with the entry.
+      std::string const& dir = this->OD->OriginalDirectories[i];
       if (dir != this->Directory &&
           cmSystemTools::GetRealPath(dir) !=
             cmSystemTools::GetRealPath(this->Directory) &&
@@ -102,6 +105,11 @@ public:
 protected:
   virtual bool FindConflict(std::string const& dir) = 0;
 
+  // Add the directories that hold files FindConflict may consider.
+  virtual void AddCandidateDirectories(std::set<unsigned int>& dirs) = 0;
+
+  std::vector<unsigned int> FindCandidateDirectories();
+
   bool FileMayConflict(std::string const& dir, std::string const& name);
 
   cmOrderDirectories* OD;
@@ -116,6 +124,21 @@ protected:
   int DirectoryIndex;
 };
 
+std::vector<unsigned int>
+cmOrderDirectoriesConstraint::FindCandidateDirectories()
+{
+  if (!this->OD->DirectoriesIndexed) {
+    std::vector<unsigned int> all(this->OD->OriginalDirectories.size());
+    std::iota(all.begin(), all.end(), 0u);
+    return all;
+  }
+  // Directories whose content is not known are always checked.
+  std::set<unsigned int> dirs(this->OD->UnindexedDirectories.begin(),
+                              this->OD->UnindexedDirectories.end());
+  this->AddCandidateDirectories(dirs);
+  return std::vector<unsigned int>(dirs.begin(), dirs.end());
+}
+
 bool cmOrderDirectoriesConstraint::FileMayConflict(std::string const& dir,
                                                    std::string const& name)
 {
@@ -165,6 +188,15 @@ public:
 
   bool FindConflict(std::string const& dir) override;
 
+  void AddCandidateDirectories(std::set<unsigned int>& dirs) override
+  {
+    if (!this->SOName.empty()) {
+      this->OD->AddIndexedDirectories(this->SOName, dirs);
+    } else {
+      this->OD->AddIndexedPrefixDirectories(this->FileName, dirs);
+    }
+  }
+
 private:
   // The soname of the shared library if it is known.
   std::string SOName;
@@ -213,8 +245,28 @@ public:
   }
 
   bool FindConflict(std::string const& dir) override;
+
+  void AddCandidateDirectories(std::set<unsigned int>& dirs) override;
 };
 
+void cmOrderDirectoriesConstraintLibrary::AddCandidateDirectories(
+  std::set<unsigned int>& dirs)
+{
+  this->OD->AddIndexedDirectories(this->FileName, dirs);
+
+  // Also consider the other extensions the linker might look for.
+  if (!this->OD->LinkExtensions.empty() &&
+      this->OD->RemoveLibraryExtension.find(this->FileName)) {
+    std::string lib = this->OD->RemoveLibraryExtension.match(1);
+    std::string ext = this->OD->RemoveLibraryExtension.match(2);
+    for (std::string const& LinkExtension : this->OD->LinkExtensions) {
+      if (LinkExtension != ext) {
+        this->OD->AddIndexedDirectories(cmStrCat(lib, LinkExtension), dirs);
+      }
+    }
+  }
+}
+
 bool cmOrderDirectoriesConstraintLibrary::FindConflict(std::string const& dir)
 {
   // We have the library file name.  Check if it will be found.
@@ -430,6 +482,27 @@ void cmOrderDirectories::FindConflicts()
   this->ConflictGraph.resize(this->OriginalDirectories.size());
   this->DirectoryVisited.resize(this->OriginalDirectories.size(), 0);
 
+  // Index the files in each directory so that every entry checks only
+  // the directories that may hold a conflicting file.  Indexing costs
+  // a map insertion per file while checking a directory costs a file
+  // system query, so index only if there are more entry and directory
+  // pairs to check than files to index.
+  std::vector<std::set<std::string> const*> contents;
+  contents.reserve(this->OriginalDirectories.size());
+  std::size_t files = 0;
+  for (std::string const& dir : this->OriginalDirectories) {
+    // The global generator caches the directory content, including
+    // files that will be generated by the build.
+    contents.push_back(&this->GlobalGenerator->GetDirectoryContent(dir));
+    files += contents.back()->size();
+  }
+  std::size_t const pairs =
+    (this->ConstraintEntries.size() + this->ImplicitDirEntries.size()) *
+    this->OriginalDirectories.size();
+  if (pairs > files) {
+    this->IndexDirectories(contents);
+  }
+
   // Find directories conflicting with each entry.
   for (unsigned int i = 0; i < this->ConstraintEntries.size(); ++i) {
     this->ConstraintEntries[i]->FindConflicts(i);
@@ -545,6 +618,57 @@ void cmOrderDirectories::DiagnoseCycle()
     MessageType::WARNING, e.str(), this->Target->GetBacktrace());
 }
 
+void cmOrderDirectories::IndexDirectories(
+  std::vector<std::set<std::string> const*> const& contents)
+{
+  this->DirectoriesIndexed = true;
+  for (unsigned int i = 0; i < contents.size(); ++i) {
+    std::set<std::string> const& files = *contents[i];
+    if (files.empty()) {
+      // The directory may be missing or unreadable.
+      this->UnindexedDirectories.push_back(i);
+      continue;
+    }
+    for (std::string const& f : files) {
+      this->DirectoryFileIndex[GetIndexKey(f)].push_back(i);
+    }
+  }
+}
+
+void cmOrderDirectories::AddIndexedDirectories(std::string const& name,
+                                               std::set<unsigned int>& dirs)
+{
+  auto i = this->DirectoryFileIndex.find(GetIndexKey(name));
+  if (i != this->DirectoryFileIndex.end()) {
+    dirs.insert(i->second.begin(), i->second.end());
+  }
+}
+
+void cmOrderDirectories::AddIndexedPrefixDirectories(
+  std::string const& prefix, std::set<unsigned int>& dirs)
+{
+  if (prefix.empty()) {
+    return;
+  }
+  std::string base = GetIndexKey(prefix);
+  auto first = this->DirectoryFileIndex.lower_bound(base);
+  ++base.back();
+  auto last = this->DirectoryFileIndex.upper_bound(base);
+  for (auto i = first; i != last; ++i) {
+    dirs.insert(i->second.begin(), i->second.end());
+  }
+}
+
+std::string cmOrderDirectories::GetIndexKey(std::string const& name)
+{
+#if defined(_WIN32) || defined(__APPLE__)
+  // File systems on these hosts are usually case-insensitive.
+  return cmSystemTools::LowerCase(name);
+#else
+  return name;
+#endif
+}
+
 bool cmOrderDirectories::IsSameDirectory(std::string const& l,
                                          std::string const& r)
 {
@@ -59,11 +59,26 @@ private:
   std::vector<std::string> OriginalDirectories;
   std::map<std::string, int> DirectoryIndex;
   std::vector<int> DirectoryVisited;
+
+  // Map from the file names found in the original directories to the
+  // indices of the directories holding them.  Directories whose
+  // content could not be read are listed separately.  Built only when
+  // there are enough entries to check for it to pay off.
+  bool DirectoriesIndexed = false;
+  std::map<std::string, std::vector<unsigned int>> DirectoryFileIndex;
+  std::vector<unsigned int> UnindexedDirectories;
   void CollectOriginalDirectories();
   int AddOriginalDirectory(std::string const& dir);
   void AddOriginalDirectories(std::vector<std::string> const& dirs);
   void FindConflicts();
   void FindImplicitConflicts();
+  void IndexDirectories(
+    std::vector<std::set<std::string> const*> const& contents);
+  void AddIndexedDirectories(std::string const& name,
+                             std::set<unsigned int>& dirs);
+  void AddIndexedPrefixDirectories(std::string const& prefix,
+                                   std::set<unsigned int>& dirs);
+  static std::string GetIndexKey(std::string const& name);
   void OrderDirectories();
   void VisitDirectory(unsigned int i);
   void DiagnoseCycle();
@@ -93,4 +108,5 @@ private:
 
   friend class cmOrderDirectoriesConstraint;
   friend class cmOrderDirectoriesConstraintLibrary;
+  friend class cmOrderDirectoriesConstraintSOName;
 };
@@ -102,10 +102,21 @@ void cmOutputConverter::SetRelativePathTop(std::string const& topSource,
   this->RelativePathTopSource = topSource;
   this->RelativePathTopBinary = topBinary;
   this->ComputeRelativePathTopRelation();
+  this->RelativePaths.Clear();
 }
 
 std::string cmOutputConverter::MaybeRelativeTo(
   std::string const& local_path, std::string const& remote_path) const
+{
+  return this->RelativePaths.Get(
+    remote_path, local_path,
+    [this](std::string const& remote, std::string const& local) {
+      return this->ComputeMaybeRelativeTo(local, remote);
+    });
+}
+
+std::string cmOutputConverter::ComputeMaybeRelativeTo(
+  std::string const& local_path, std::string const& remote_path) const
 {
   bool localInBinary = PathEqOrSubDir(local_path, this->RelativePathTopBinary);
   bool remoteInBinary =
@@ -8,6 +8,7 @@
 
 #include <cm/string_view>
 
+#include "cmPathCache.h"
 #include "cmStateSnapshot.h"
 
 class cmState;
@@ -176,4 +177,9 @@ private:
   void ComputeRelativePathTopRelation();
   std::string MaybeRelativeTo(std::string const& local_path,
                               std::string const& remote_path) const;
+  std::string ComputeMaybeRelativeTo(std::string const& local_path,
+                                     std::string const& remote_path) const;
+
+  // Results of MaybeRelativeTo for the current top directories.
+  mutable cmPathCache RelativePaths;
 };
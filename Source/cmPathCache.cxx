@@ -0,0 +1,87 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmPathCache.h"
+
+#include <atomic>
+#include <utility>
+
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+namespace {
+std::atomic<std::size_t> TotalHits(0);
+std::atomic<std::size_t> TotalMisses(0);
+
+cmPathCache& GetSharedCache()
+{
+  static cmPathCache cache;
+  return cache;
+}
+}
+
+cmPathCache::cmPathCache(cmPathCache const&)
+{
+}
+
+cmPathCache& cmPathCache::operator=(cmPathCache const& other)
+{
+  if (this != &other) {
+    this->Clear();
+  }
+  return *this;
+}
+
+std::string cmPathCache::Get(
+  std::string const& path, std::string const& base,
+  std::function<std::string(std::string const&, std::string const&)> const&
+    compute)
+{
+  // A path never contains a NUL character, so it separates the parts.
+  std::string key = cmStrCat(base, '\0', path);
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto i = this->Results.find(key);
+    if (i != this->Results.end()) {
+      ++TotalHits;
+      return i->second;
+    }
+  }
+
+  ++TotalMisses;
+  std::string result = compute(path, base);
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->Results.emplace(std::move(key), result);
+  return result;
+}
+
+void cmPathCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->Results.clear();
+}
+
+std::string cmPathCache::CollapseFullPath(std::string const& path,
+                                          std::string const& base)
+{
+  // A relative base is interpreted against the working directory.
+  if (!cmSystemTools::FileIsFullPath(base)) {
+    return cmSystemTools::CollapseFullPath(path, base);
+  }
+  return GetSharedCache().Get(
+    path, base, [](std::string const& p, std::string const& b) {
+      return cmSystemTools::CollapseFullPath(p, b);
+    });
+}
+
+void cmPathCache::ClearShared()
+{
+  GetSharedCache().Clear();
+}
+
+cmPathCache::Statistics cmPathCache::GetStatistics()
+{
+  Statistics stats;
+  stats.Hits = TotalHits;
+  stats.Misses = TotalMisses;
+  return stats;
+}
@@ -0,0 +1,61 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/** \class cmPathCache
+ * \brief Memoize path computations keyed on a path and a base directory.
+ *
+ * Generators collapse and relativize the same include directories,
+ * sources and object paths over and over.  A cache maps each (path,
+ * base) pair to the result computed the first time it was seen.
+ * Caches may be used from multiple threads.
+ */
+class cmPathCache
+{
+public:
+  cmPathCache() = default;
+
+  // Copies start out empty.
+  cmPathCache(cmPathCache const&);
+  cmPathCache& operator=(cmPathCache const&);
+
+  /** Return the result for \a path relative to \a base, calling
+      \a compute to produce it if it is not yet known.  */
+  std::string Get(
+    std::string const& path, std::string const& base,
+    std::function<std::string(std::string const&, std::string const&)> const&
+      compute);
+
+  void Clear();
+
+  /** Collapse \a path with respect to the full path \a base as
+      cmSystemTools::CollapseFullPath does, sharing the results
+      process-wide.  */
+  static std::string CollapseFullPath(std::string const& path,
+                                      std::string const& base);
+
+  /** Drop the results shared by CollapseFullPath.  Called between
+      generate steps so stale entries do not accumulate.  */
+  static void ClearShared();
+
+  struct Statistics
+  {
+    std::size_t Hits = 0;
+    std::size_t Misses = 0;
+  };
+
+  /** Get the counters accumulated so far by all caches.  */
+  static Statistics GetStatistics();
+
+private:
+  std::mutex Mutex;
+  std::unordered_map<std::string, std::string> Results;
+};
@@ -3,6 +3,7 @@
 #include "cmPolicies.h"
 
 #include <cassert>
+#include <cstddef>
 #include <cstdio>
 #include <cstring>
 #include <sstream>
@@ -462,3 +463,29 @@ bool cmPolicies::PolicyMap::IsEmpty() const
 {
   return this->Status.none();
 }
+
+void cmPolicies::PolicyMap::Update(PolicyMap const& other)
+{
+  using StatusBits = decltype(this->Status);
+
+  // Each policy occupies POLICY_STATUS_COUNT adjacent bits, at most one
+  // of which is set.  Build a mask that covers every group in which
+  // 'other' has a value, then replace those groups.
+  static StatusBits const groupStarts = []() {
+    StatusBits bits;
+    for (std::size_t i = 0; i < bits.size(); i += POLICY_STATUS_COUNT) {
+      bits.set(i);
+    }
+    return bits;
+  }();
+  StatusBits defined = other.Status;
+  for (int i = 1; i < POLICY_STATUS_COUNT; ++i) {
+    defined |= other.Status >> i;
+  }
+  defined &= groupStarts;
+  StatusBits mask = defined;
+  for (int i = 1; i < POLICY_STATUS_COUNT; ++i) {
+    mask |= defined << i;
+  }
+  this->Status = (this->Status & ~mask) | other.Status;
+}
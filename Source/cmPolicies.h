@@ -796,6 +796,9 @@ public:
     bool IsDefined(PolicyID id) const;
     bool IsEmpty() const;
 
+    /** Take the value of every policy that is defined in \a other.  */
+    void Update(PolicyMap const& other);
+
   private:
 #define POLICY_STATUS_COUNT 3
     std::bitset<cmPolicies::CMPCOUNT * POLICY_STATUS_COUNT> Status;
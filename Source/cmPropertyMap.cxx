@@ -3,8 +3,94 @@
 #include "cmPropertyMap.h"
 
 #include <algorithm>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
+#include <cm/memory>
+#include <cm/shared_mutex>
+#include <cm/string_view>
+
+#if defined(__clang__) && defined(__has_feature)
+#  if !__has_feature(cxx_thread_local)
+#    define CM_PROPERTY_MAP_NO_THREAD_LOCAL
+#  endif
+#endif
+
+namespace {
+struct NameTable
+{
+  cm::shared_mutex Mutex;
+  // Elements of an unordered_set never move, so their addresses can
+  // serve as property name ids.
+  std::unordered_set<std::string> Names;
+};
+
+NameTable& GetNameTable()
+{
+  static NameTable table;
+  return table;
+}
+
+std::string const* InternNameLocked(std::string const& name)
+{
+  NameTable& table = GetNameTable();
+  {
+    cm::shared_lock<cm::shared_mutex> lock(table.Mutex);
+    auto it = table.Names.find(name);
+    if (it != table.Names.end()) {
+      return &*it;
+    }
+  }
+  std::lock_guard<cm::shared_mutex> lock(table.Mutex);
+  return &*table.Names.insert(name).first;
+}
+
+std::string const* InternName(std::string const& name)
+{
+#ifdef CM_PROPERTY_MAP_NO_THREAD_LOCAL
+  return InternNameLocked(name);
+#else
+  // Interned names are never removed, so each thread keeps the ids it
+  // has resolved and finds them again without taking the lock.
+  thread_local std::unordered_map<cm::string_view, std::string const*> ids;
+  auto it = ids.find(name);
+  if (it != ids.end()) {
+    return it->second;
+  }
+  std::string const* id = InternNameLocked(name);
+  ids.emplace(*id, id);
+  return id;
+#endif
+}
+
+template <typename Entry>
+bool NameLess(Entry const& entry, std::string const* name)
+{
+  return std::less<std::string const*>()(entry.first, name);
+}
+}
+
+cmPropertyMap::cmPropertyMap(cmPropertyMap const& other)
+{
+  *this = other;
+}
+
+cmPropertyMap& cmPropertyMap::operator=(cmPropertyMap const& other)
+{
+  if (this != &other) {
+    std::vector<Entry> map;
+    map.reserve(other.Map_.size());
+    for (Entry const& item : other.Map_) {
+      map.emplace_back(item.first, cm::make_unique<std::string>(*item.second));
+    }
+    this->Map_ = std::move(map);
+  }
+  return *this;
+}
+
 void cmPropertyMap::Clear()
 {
   this->Map_.clear();
@@ -13,11 +99,11 @@ void cmPropertyMap::Clear()
 void cmPropertyMap::SetProperty(std::string const& name, cmValue value)
 {
   if (!value) {
-    this->Map_.erase(name);
+    this->RemoveProperty(name);
     return;
   }
 
-  this->Map_[name] = *value;
+  this->GetOrCreate(name) = *value;
 }
 
 void cmPropertyMap::AppendProperty(std::string const& name,
@@ -29,7 +115,7 @@ void cmPropertyMap::AppendProperty(std::string const& name,
   }
 
   {
-    std::string& pVal = this->Map_[name];
+    std::string& pVal = this->GetOrCreate(name);
     if (!pVal.empty() && !asString) {
       pVal += ';';
     }
@@ -39,14 +125,17 @@ void cmPropertyMap::AppendProperty(std::string const& name,
 
 void cmPropertyMap::RemoveProperty(std::string const& name)
 {
-  this->Map_.erase(name);
+  auto it = this->Find(name);
+  if (it != this->Map_.cend()) {
+    this->Map_.erase(it);
+  }
 }
 
 cmValue cmPropertyMap::GetPropertyValue(std::string const& name) const
 {
-  auto it = this->Map_.find(name);
-  if (it != this->Map_.end()) {
-    return cmValue(it->second);
+  auto it = this->Find(name);
+  if (it != this->Map_.cend()) {
+    return cmValue(*it->second);
   }
   return nullptr;
 }
@@ -56,7 +145,7 @@ std::vector<std::string> cmPropertyMap::GetKeys() const
   std::vector<std::string> keyList;
   keyList.reserve(this->Map_.size());
   for (auto const& item : this->Map_) {
-    keyList.push_back(item.first);
+    keyList.push_back(*item.first);
   }
   std::sort(keyList.begin(), keyList.end());
   return keyList;
@@ -68,7 +157,7 @@ std::vector<std::pair<std::string, std::string>> cmPropertyMap::GetList() const
   std::vector<StringPair> kvList;
   kvList.reserve(this->Map_.size());
   for (auto const& item : this->Map_) {
-    kvList.emplace_back(item.first, item.second);
+    kvList.emplace_back(*item.first, *item.second);
   }
   std::sort(kvList.begin(), kvList.end(),
             [](StringPair const& a, StringPair const& b) {
@@ -76,3 +165,41 @@ std::vector<std::pair<std::string, std::string>> cmPropertyMap::GetList() const
             });
   return kvList;
 }
+
+std::size_t cmPropertyMap::GetMemoryUsage() const
+{
+  std::size_t bytes = this->Map_.capacity() * sizeof(Entry);
+  for (auto const& item : this->Map_) {
+    std::string const& value = *item.second;
+    bytes += sizeof(std::string);
+    // Short values are stored inside the string object itself.
+    char const* object = reinterpret_cast<char const*>(&value);
+    if (value.data() < object || value.data() >= object + sizeof(value)) {
+      bytes += value.capacity() + 1;
+    }
+  }
+  return bytes;
+}
+
+std::string& cmPropertyMap::GetOrCreate(std::string const& name)
+{
+  Name const id = InternName(name);
+  auto it = std::lower_bound(this->Map_.begin(), this->Map_.end(), id,
+                             NameLess<Entry>);
+  if (it == this->Map_.end() || it->first != id) {
+    it = this->Map_.emplace(it, id, cm::make_unique<std::string>());
+  }
+  return *it->second;
+}
+
+std::vector<cmPropertyMap::Entry>::const_iterator cmPropertyMap::Find(
+  std::string const& name) const
+{
+  Name const id = InternName(name);
+  auto it = std::lower_bound(this->Map_.cbegin(), this->Map_.cend(), id,
+                             NameLess<Entry>);
+  if (it != this->Map_.cend() && it->first == id) {
+    return it;
+  }
+  return this->Map_.cend();
+}
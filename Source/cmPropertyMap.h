@@ -4,8 +4,9 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
+#include <memory>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -13,11 +14,22 @@
 
 /** \class cmPropertyMap
  * \brief String property map.
+ *
+ * Property names are interned process-wide, so each map stores only a
+ * pointer to the shared name next to its value.  Entries are kept in a
+ * vector sorted by that pointer.  Values live in their own allocations
+ * so that a cmValue obtained from the map stays valid while other
+ * properties are added or removed.
  */
 class cmPropertyMap
 {
 public:
   // -- General
+  cmPropertyMap() = default;
+  cmPropertyMap(cmPropertyMap const& other);
+  cmPropertyMap(cmPropertyMap&&) noexcept = default;
+  cmPropertyMap& operator=(cmPropertyMap const& other);
+  cmPropertyMap& operator=(cmPropertyMap&&) noexcept = default;
 
   //! Clear property list
   void Clear();
@@ -49,6 +61,15 @@ public:
   //! Get a sorted by key list of property key,value pairs
   std::vector<std::pair<std::string, std::string>> GetList() const;
 
+  //! Estimate the number of bytes used by the map and its values
+  std::size_t GetMemoryUsage() const;
+
 private:
-  std::unordered_map<std::string, std::string> Map_;
+  using Name = std::string const*;
+  using Entry = std::pair<Name, std::unique_ptr<std::string>>;
+
+  std::string& GetOrCreate(std::string const& name);
+  std::vector<Entry>::const_iterator Find(std::string const& name) const;
+
+  std::vector<Entry> Map_;
 };
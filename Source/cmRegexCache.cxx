@@ -0,0 +1,91 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmRegexCache.h"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+// Entries are shared so that a caller may copy a compiled pattern
+// outside of the lock while another thread evicts it.
+using RegexPtr = std::shared_ptr<cmsys::RegularExpression const>;
+
+struct Entry
+{
+  Entry(std::string pattern, RegexPtr regex)
+    : Pattern(std::move(pattern))
+    , Regex(std::move(regex))
+  {
+  }
+  std::string Pattern;
+  RegexPtr Regex;
+};
+
+struct Cache
+{
+  std::mutex Mutex;
+  // Most recently used entries are at the front.
+  std::list<Entry> Entries;
+  std::unordered_map<std::string, std::list<Entry>::iterator> Index;
+  cmRegexCache::Statistics Stats;
+};
+
+Cache& GetCache()
+{
+  static Cache cache;
+  return cache;
+}
+}
+
+bool cmRegexCache::Compile(cmsys::RegularExpression& regex,
+                           std::string const& pattern)
+{
+  Cache& cache = GetCache();
+  RegexPtr cached;
+  {
+    std::lock_guard<std::mutex> lock(cache.Mutex);
+    auto i = cache.Index.find(pattern);
+    if (i != cache.Index.end()) {
+      ++cache.Stats.Hits;
+      cache.Entries.splice(cache.Entries.begin(), cache.Entries, i->second);
+      cached = i->second->Regex;
+    } else {
+      ++cache.Stats.Misses;
+    }
+  }
+  if (cached) {
+    regex = *cached;
+    return true;
+  }
+
+  // Compile without holding the lock.
+  if (!regex.compile(pattern)) {
+    return false;
+  }
+  auto compiled = std::make_shared<cmsys::RegularExpression const>(regex);
+
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  if (cache.Index.find(pattern) != cache.Index.end()) {
+    // Another thread compiled the same pattern meanwhile.
+    return true;
+  }
+  if (cache.Entries.size() >= Capacity) {
+    cache.Index.erase(cache.Entries.back().Pattern);
+    cache.Entries.pop_back();
+  }
+  cache.Entries.emplace_front(pattern, std::move(compiled));
+  cache.Index.emplace(pattern, cache.Entries.begin());
+  return true;
+}
+
+cmRegexCache::Statistics cmRegexCache::GetStatistics()
+{
+  Cache& cache = GetCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  Statistics stats = cache.Stats;
+  stats.Size = cache.Entries.size();
+  return stats;
+}
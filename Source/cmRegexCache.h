@@ -0,0 +1,42 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <string>
+
+#include "cmsys/RegularExpression.hxx"
+
+/** \class cmRegexCache
+ * \brief Process-wide cache of compiled regular expressions.
+ *
+ * Commands taking a regular expression are often called in loops with
+ * the same pattern.  This keeps the most recently used compiled
+ * patterns so that such calls copy the compiled program instead of
+ * compiling the pattern again.  The cache may be used from several
+ * threads; callers always receive their own copy of the program.
+ */
+class cmRegexCache
+{
+public:
+  /** Maximum number of compiled patterns kept in the cache.  */
+  static std::size_t const Capacity = 256;
+
+  /** Compile \a pattern into \a regex, reusing a cached compilation if
+      possible.  Returns false if the pattern is not valid.  Invalid
+      patterns are not cached, so each attempt reports its error.  */
+  static bool Compile(cmsys::RegularExpression& regex,
+                      std::string const& pattern);
+
+  struct Statistics
+  {
+    std::size_t Hits = 0;
+    std::size_t Misses = 0;
+    std::size_t Size = 0;
+  };
+
+  /** Get the cache counters accumulated so far.  */
+  static Statistics GetStatistics();
+};
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
 #include <utility>
@@ -33,6 +34,10 @@ namespace cmStateDetail {
 std::string const PropertySentinel = std::string{};
 } // namespace cmStateDetail
 
+namespace {
+std::atomic<std::size_t> LastCommandGeneration{ 0 };
+}
+
 cmState::cmState(Role role, TryCompile isTryCompile)
   : StateRole(role)
   , IsTryCompile(isTryCompile)
@@ -409,6 +414,7 @@ void cmState::AddBuiltinCommand(std::string const& name, Command command)
 {
   assert(name == cmSystemTools::LowerCase(name));
   assert(this->BuiltinCommands.find(name) == this->BuiltinCommands.end());
+  this->CommandGeneration = ++LastCommandGeneration;
   this->BuiltinCommands.emplace(
     name,
     CommandDescriptor{ cmStateEnums::CommandType::Function,
@@ -561,6 +567,7 @@ bool cmState::AddScriptedCommand(std::string const& name,
 
   this->ScriptedCommands[sName] =
     CommandDescriptor{ type, std::move(command.Value) };
+  this->CommandGeneration = ++LastCommandGeneration;
   return true;
 }
 
@@ -630,11 +637,13 @@ std::vector<std::string> cmState::GetCommandNames() const
 void cmState::RemoveBuiltinCommand(std::string const& name)
 {
   assert(name == cmSystemTools::LowerCase(name));
+  this->CommandGeneration = ++LastCommandGeneration;
   this->BuiltinCommands.erase(name);
 }
 
 void cmState::RemoveUserDefinedCommands()
 {
+  this->CommandGeneration = ++LastCommandGeneration;
   this->ScriptedCommands.clear();
 }
 
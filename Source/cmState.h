@@ -4,6 +4,7 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
 #include <functional>
 #include <map>
 #include <memory>
@@ -202,6 +203,11 @@ public:
   void RemoveUserDefinedCommands();
   std::vector<std::string> GetCommandNames() const;
 
+  // Returns a value that changes whenever a command is added, replaced, or
+  // removed.  Values are unique across all cmState instances in a process,
+  // so a resolved command may be reused while the generation is unchanged.
+  std::size_t GetCommandGeneration() const { return this->CommandGeneration; }
+
   void SetGlobalProperty(std::string const& prop, std::string const& value);
   void SetGlobalProperty(std::string const& prop, cmValue value);
   void AppendGlobalProperty(std::string const& prop, std::string const& value,
@@ -329,6 +335,7 @@ private:
 
   std::unordered_map<std::string, CommandDescriptor> BuiltinCommands;
   std::unordered_map<std::string, CommandDescriptor> ScriptedCommands;
+  std::size_t CommandGeneration = 0;
   std::unordered_set<std::string> FlowControlCommands;
   cmPropertyMap GlobalProperties;
   std::unique_ptr<cmCacheManager> CacheManager;
@@ -341,6 +348,8 @@ private:
 
   cmLinkedTree<cmStateDetail::DiagnosticStackEntry> DiagnosticStack;
   cmLinkedTree<cmStateDetail::PolicyStackEntry> PolicyStack;
+  // Incremented whenever an existing policy stack entry changes.
+  std::size_t PolicyGeneration = 1;
   cmLinkedTree<cmStateDetail::SnapshotDataType> SnapshotData;
   cmLinkedTree<cmDefinitions> VarTree;
 
@@ -5,6 +5,7 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -67,6 +68,12 @@ struct cmStateDetail::PolicyStackEntry : public cmPolicies::PolicyMap
   {
   }
   bool Weak;
+
+  // Settings of this entry combined with every entry below it in the
+  // policy stack tree.  Valid while FlattenedGeneration matches the
+  // owning cmState's policy generation.
+  cmPolicies::PolicyMap Flattened;
+  std::size_t FlattenedGeneration = 0;
 };
 
 struct cmStateDetail::DiagnosticStackEntry
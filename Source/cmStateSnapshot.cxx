@@ -152,6 +152,68 @@ cmStateSnapshot cmStateSnapshot::GetCallStackBottom() const
   return { this->State, pos };
 }
 
+namespace {
+using PolicyStackIterator =
+  cmLinkedTree<cmStateDetail::PolicyStackEntry>::iterator;
+
+// Return the settings of 'entry' combined with every entry below it in
+// the policy stack tree, bringing stale views up to date on the way.
+cmPolicies::PolicyMap const& GetFlattenedPolicies(
+  cmLinkedTree<cmStateDetail::PolicyStackEntry> const& stack,
+  PolicyStackIterator entry, std::size_t generation)
+{
+  static cmPolicies::PolicyMap const empty;
+  PolicyStackIterator const root = stack.Root();
+  if (entry == root) {
+    return empty;
+  }
+  if (entry->FlattenedGeneration == generation) {
+    return entry->Flattened;
+  }
+
+  // Collect the entries whose views are stale, down to the nearest one
+  // that is current.  Usually only the newly pushed entry is.
+  std::vector<PolicyStackIterator> stale;
+  PolicyStackIterator it = entry;
+  while (it != root && it->FlattenedGeneration != generation) {
+    stale.push_back(it);
+    ++it;
+  }
+  cmPolicies::PolicyMap const* below = it == root ? &empty : &it->Flattened;
+  for (auto si = stale.rbegin(); si != stale.rend(); ++si) {
+    cmStateDetail::PolicyStackEntry& e = **si;
+    e.Flattened = *below;
+    e.Flattened.Update(e);
+    e.FlattenedGeneration = generation;
+    below = &e.Flattened;
+  }
+  return *below;
+}
+}
+
+bool cmStateSnapshot::HasFlattenedPolicies() const
+{
+  // The flattened view of an entry follows the policy stack tree, which
+  // continues from a directory's root into the entry of the parent
+  // directory that created it.  Lookups instead continue from the
+  // parent directory's current entry.  The two agree while every parent
+  // directory is still at the entry from which its child was created,
+  // which is always the case while the child is being configured.
+  cmLinkedTree<cmStateDetail::BuildsystemDirectoryStateType>::iterator dir =
+    this->Position->BuildSystemDirectory;
+  while (true) {
+    cmStateDetail::PositionType e = dir->CurrentScope;
+    cmStateDetail::PositionType p = e->DirectoryParent;
+    if (p == this->State->SnapshotData.Root()) {
+      return e->PolicyRoot == this->State->PolicyStack.Root();
+    }
+    dir = p->BuildSystemDirectory;
+    if (e->PolicyRoot != dir->CurrentScope->Policies) {
+      return false;
+    }
+  }
+}
+
 void cmStateSnapshot::PushPolicy(cmPolicies::PolicyMap const& entry, bool weak)
 {
   cmStateDetail::PositionType pos = this->Position;
@@ -185,6 +247,7 @@ void cmStateSnapshot::SetPolicy(cmPolicies::PolicyID id,
     psi->Set(id, status);
     previous_was_weak = psi->Weak;
   }
+  ++this->State->PolicyGeneration;
 }
 
 cmPolicies::PolicyStatus cmStateSnapshot::GetPolicy(cmPolicies::PolicyID id,
@@ -194,6 +257,14 @@ cmPolicies::PolicyStatus cmStateSnapshot::GetPolicy(cmPolicies::PolicyID id,
     return cmPolicies::NEW;
   }
 
+  if (!parent_scope && this->HasFlattenedPolicies()) {
+    cmPolicies::PolicyMap const& policies = GetFlattenedPolicies(
+      this->State->PolicyStack,
+      this->Position->BuildSystemDirectory->CurrentScope->Policies,
+      this->State->PolicyGeneration);
+    return policies.Get(id);
+  }
+
   cmPolicies::PolicyStatus status = cmPolicies::WARN;
 
   cmLinkedTree<cmStateDetail::BuildsystemDirectoryStateType>::iterator dir =
@@ -232,6 +303,13 @@ cmPolicies::PolicyStatus cmStateSnapshot::GetScopePolicy(
     return cmPolicies::NEW;
   }
 
+  if (this->HasFlattenedPolicies()) {
+    cmPolicies::PolicyMap const& policies =
+      GetFlattenedPolicies(this->State->PolicyStack, this->Position->Policies,
+                           this->State->PolicyGeneration);
+    return policies.Get(id);
+  }
+
   cmPolicies::PolicyStatus status = cmPolicies::WARN;
 
   cmLinkedTree<cmStateDetail::BuildsystemDirectoryStateType>::iterator dir =
@@ -403,6 +481,14 @@ void cmStateSnapshot::SetDefinition(std::string const& name,
   this->Position->Vars->Set(name, value);
 }
 
+void cmStateSnapshot::AppendDefinition(std::string const& name,
+                                       cm::string_view value,
+                                       cm::string_view separator)
+{
+  cmDefinitions::Append(name, value, separator, this->Position->Vars,
+                        this->Position->Root);
+}
+
 void cmStateSnapshot::RemoveDefinition(std::string const& name)
 {
   this->Position->Vars->Unset(name);
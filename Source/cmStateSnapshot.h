@@ -28,6 +28,8 @@ public:
   cmValue GetDefinition(std::string const& name) const;
   bool IsInitialized(std::string const& name) const;
   void SetDefinition(std::string const& name, cm::string_view value);
+  void AppendDefinition(std::string const& name, cm::string_view value,
+                        cm::string_view separator);
   void RemoveDefinition(std::string const& name);
   std::vector<std::string> ClosureKeys() const;
   std::vector<std::string> LocalKeys() const;
@@ -121,6 +123,7 @@ private:
   friend struct StrictWeakOrder;
 
   void InitializeFromParent();
+  bool HasFlattenedPolicies() const;
 
   using AlterDiagnosticFunction = bool (*)(cmDiagnosticAction current,
                                            cmDiagnosticAction desired);
@@ -78,6 +78,7 @@ enum class TraceOutputFormat
 {
   Undefined,
   Human,
-  JSONv1
+  JSONv1,
+  BinaryV1
 };
 };
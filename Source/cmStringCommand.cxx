@@ -476,11 +476,8 @@ bool HandleAppendCommand(std::vector<std::string> const& args,
     return true;
   }
 
-  auto const& variableName = args[1];
-  cm::CMakeString data{ status.GetMakefile().GetDefinition(variableName) };
-
-  data.Append(cmMakeRange(args).advance(2));
-  status.GetMakefile().AddDefinition(variableName, data);
+  status.GetMakefile().AppendDefinition(
+    args[1], cmJoin(cmMakeRange(args).advance(2), ""), cm::string_view());
 
   return true;
 }
@@ -1226,6 +1223,7 @@ bool cmStringCommand(std::vector<std::string> const& args,
     { "SHA3_256"_s, HandleHashCommand },
     { "SHA3_384"_s, HandleHashCommand },
     { "SHA3_512"_s, HandleHashCommand },
+    { "RAPIDHASH"_s, HandleHashCommand },
     { "TOLOWER"_s, HandleToLowerCommand },
     { "TOUPPER"_s, HandleToUpperCommand },
     { "COMPARE"_s, HandleCompareCommand },
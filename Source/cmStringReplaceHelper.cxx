@@ -8,15 +8,16 @@
 
 #include "cmMakefile.h"
 #include "cmPolicies.h"
+#include "cmRegexCache.h"
 
 cmStringReplaceHelper::cmStringReplaceHelper(std::string const& regex,
                                              std::string replace_expr,
                                              cmMakefile* makefile)
   : RegExString(regex)
-  , RegularExpression(regex)
   , ReplaceExpression(std::move(replace_expr))
   , Makefile(makefile)
 {
+  cmRegexCache::Compile(this->RegularExpression, regex);
   this->ParseReplaceExpression();
 }
 
@@ -76,6 +76,11 @@ public:
     return this->ge->GetHadContextSensitiveCondition();
   }
 
+  bool GetHadConfigSensitiveCondition() const override
+  {
+    return this->ge->GetHadConfigSensitiveCondition();
+  }
+
 private:
   std::unique_ptr<cmCompiledGeneratorExpression> const ge;
 };
@@ -106,4 +111,9 @@ bool TargetPropertyEntry::GetHadContextSensitiveCondition() const
 {
   return false;
 }
+
+bool TargetPropertyEntry::GetHadConfigSensitiveCondition() const
+{
+  return false;
+}
 }
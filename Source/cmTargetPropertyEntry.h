@@ -37,6 +37,7 @@ public:
   virtual cmListFileBacktrace GetBacktrace() const = 0;
   virtual std::string const& GetInput() const = 0;
   virtual bool GetHadContextSensitiveCondition() const;
+  virtual bool GetHadConfigSensitiveCondition() const;
 
   cmLinkItem const& LinkItem;
 };
@@ -0,0 +1,359 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmTraceRecord.h"
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <utility>
+
+#ifndef CMAKE_BOOTSTRAP
+#  include <cm3p/json/value.h>
+#  include <cm3p/json/writer.h>
+#endif
+
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+namespace {
+// Layout of binary-v1 output:
+//
+//   header:  "CMTRACE\0" <varint major> <varint minor>
+//   string:  'S' <varint size> <bytes>
+//   command: 'C' <file> <line> <line_end - line> <defer> <cmd>
+//            <varint argc> (<varint size> <bytes>)... <time> <frame>
+//            <global_frame>
+//
+// <file>, <defer> and <cmd> are indices of previously written strings;
+// <defer> is offset by one so that zero means "not deferred".  Line
+// numbers are zigzag-encoded varints and <time> is an IEEE 754 double
+// stored in little-endian byte order.
+char const BinaryTraceMagic[8] = { 'C', 'M', 'T', 'R', 'A', 'C', 'E', '\0' };
+unsigned int const BinaryTraceMajor = 1;
+unsigned int const BinaryTraceMinor = 0;
+char const TagString = 'S';
+char const TagCommand = 'C';
+
+// Hand blocks of this size to the output stream.
+std::string::size_type const BinaryTraceBufferSize = 64 * 1024;
+
+std::uint64_t ZigZagEncode(long value)
+{
+  std::int64_t const v = value;
+  return (static_cast<std::uint64_t>(v) << 1) ^
+    static_cast<std::uint64_t>(v >> 63);
+}
+
+long ZigZagDecode(std::uint64_t value)
+{
+  return static_cast<long>(static_cast<std::int64_t>(value >> 1) ^
+                           -static_cast<std::int64_t>(value & 1));
+}
+}
+
+std::string cmTraceRecord::ToHuman() const
+{
+  std::ostringstream msg;
+  msg << this->File << '(' << this->Line << "):";
+  if (this->DeferId) {
+    msg << "DEFERRED:" << *this->DeferId << ':';
+  }
+  msg << "  " << this->Command << '(';
+  for (std::string const& arg : this->Args) {
+    msg << arg << ' ';
+  }
+  msg << ')';
+  return msg.str();
+}
+
+#ifndef CMAKE_BOOTSTRAP
+std::string cmTraceRecord::ToJSON() const
+{
+  Json::Value val;
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "";
+  val["file"] = this->File;
+  val["line"] = static_cast<Json::Value::Int64>(this->Line);
+  if (this->Line != this->LineEnd) {
+    val["line_end"] = static_cast<Json::Value::Int64>(this->LineEnd);
+  }
+  if (this->DeferId) {
+    val["defer"] = *this->DeferId;
+  }
+  val["cmd"] = this->Command;
+  val["args"] = Json::Value(Json::arrayValue);
+  for (std::string const& arg : this->Args) {
+    val["args"].append(arg);
+  }
+  val["time"] = this->Time;
+  val["frame"] = static_cast<Json::Value::UInt64>(this->Frame);
+  val["global_frame"] = static_cast<Json::Value::UInt64>(this->GlobalFrame);
+  return Json::writeString(builder, val);
+}
+
+std::string cmTraceRecord::JSONVersion()
+{
+  Json::Value val;
+  Json::Value version;
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "";
+  version["major"] = 1;
+  version["minor"] = 2;
+  val["version"] = version;
+  return Json::writeString(builder, val);
+}
+#endif
+
+bool cmTraceRecord::MatchesSource(std::string const& path,
+                                  std::vector<std::string> const& sources)
+{
+  if (sources.empty()) {
+    return true;
+  }
+  cm::string_view const only_filename =
+    cmSystemTools::GetFilenameNameView(path);
+  for (std::string const& file : sources) {
+    std::string::size_type const pos = path.rfind(file);
+    if ((pos != std::string::npos) && ((pos + file.size()) == path.size()) &&
+        (only_filename == cmSystemTools::GetFilenameNameView(file))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+cmBinaryTraceWriter::cmBinaryTraceWriter(std::ostream& out)
+  : Out(out)
+{
+  this->Buffer.reserve(BinaryTraceBufferSize);
+  this->Buffer.append(BinaryTraceMagic, sizeof(BinaryTraceMagic));
+  this->WriteVarint(BinaryTraceMajor);
+  this->WriteVarint(BinaryTraceMinor);
+}
+
+cmBinaryTraceWriter::~cmBinaryTraceWriter()
+{
+  this->Flush();
+}
+
+void cmBinaryTraceWriter::Write(cmTraceRecord const& record)
+{
+  // Define any new strings before the record that refers to them.
+  std::uint64_t const file = this->Intern(record.File);
+  std::uint64_t const command = this->Intern(record.Command);
+  std::uint64_t const defer =
+    record.DeferId ? this->Intern(*record.DeferId) + 1 : 0;
+
+  this->Buffer += TagCommand;
+  this->WriteVarint(file);
+  this->WriteVarint(ZigZagEncode(record.Line));
+  this->WriteVarint(ZigZagEncode(record.LineEnd - record.Line));
+  this->WriteVarint(defer);
+  this->WriteVarint(command);
+  this->WriteVarint(record.Args.size());
+  for (std::string const& arg : record.Args) {
+    this->WriteString(arg);
+  }
+  std::uint64_t time;
+  static_assert(sizeof(time) == sizeof(record.Time),
+                "binary-v1 trace requires 64-bit doubles");
+  std::memcpy(&time, &record.Time, sizeof(time));
+  for (int i = 0; i < 8; ++i) {
+    this->Buffer += static_cast<char>((time >> (8 * i)) & 0xff);
+  }
+  this->WriteVarint(record.Frame);
+  this->WriteVarint(record.GlobalFrame);
+
+  if (this->Buffer.size() >= BinaryTraceBufferSize) {
+    this->Flush();
+  }
+}
+
+void cmBinaryTraceWriter::Flush()
+{
+  if (!this->Buffer.empty()) {
+    this->Out.write(this->Buffer.data(),
+                    static_cast<std::streamsize>(this->Buffer.size()));
+    this->Buffer.clear();
+  }
+  this->Out.flush();
+}
+
+std::uint64_t cmBinaryTraceWriter::Intern(std::string const& value)
+{
+  auto const inserted = this->Strings.emplace(value, this->Strings.size());
+  if (inserted.second) {
+    this->Buffer += TagString;
+    this->WriteString(value);
+  }
+  return inserted.first->second;
+}
+
+void cmBinaryTraceWriter::WriteVarint(std::uint64_t value)
+{
+  while (value >= 0x80) {
+    this->Buffer += static_cast<char>((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  this->Buffer += static_cast<char>(value);
+}
+
+void cmBinaryTraceWriter::WriteString(cm::string_view value)
+{
+  this->WriteVarint(value.size());
+  this->Buffer.append(value.data(), value.size());
+}
+
+cmBinaryTraceReader::cmBinaryTraceReader(std::istream& in)
+  : In(in)
+{
+}
+
+bool cmBinaryTraceReader::Read(cmTraceRecord& record)
+{
+  if (!this->HeaderRead) {
+    if (!this->ReadHeader()) {
+      return false;
+    }
+    this->HeaderRead = true;
+  }
+
+  for (;;) {
+    int const tag = this->In.get();
+    if (tag == std::char_traits<char>::eof()) {
+      return false;
+    }
+    if (tag == TagString) {
+      std::string value;
+      if (!this->ReadString(value)) {
+        return false;
+      }
+      this->Strings.emplace_back(std::move(value));
+      continue;
+    }
+    if (tag != TagCommand) {
+      return this->Fail("unknown record type");
+    }
+
+    std::uint64_t line;
+    std::uint64_t lineEnd;
+    std::uint64_t argc;
+    std::string defer;
+    if (!this->ReadStringRef(record.File) || !this->ReadVarint(line) ||
+        !this->ReadVarint(lineEnd)) {
+      return false;
+    }
+    record.Line = ZigZagDecode(line);
+    record.LineEnd = record.Line + ZigZagDecode(lineEnd);
+    std::uint64_t deferRef;
+    if (!this->ReadVarint(deferRef)) {
+      return false;
+    }
+    if (deferRef == 0) {
+      record.DeferId = cm::nullopt;
+    } else if (deferRef <= this->Strings.size()) {
+      record.DeferId = this->Strings[deferRef - 1];
+    } else {
+      return this->Fail("invalid string reference");
+    }
+    if (!this->ReadStringRef(record.Command) || !this->ReadVarint(argc)) {
+      return false;
+    }
+    record.Args.clear();
+    for (std::uint64_t i = 0; i < argc; ++i) {
+      std::string arg;
+      if (!this->ReadString(arg)) {
+        return false;
+      }
+      record.Args.emplace_back(std::move(arg));
+    }
+    unsigned char bytes[8];
+    if (!this->In.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) {
+      return this->Fail("unexpected end of file");
+    }
+    std::uint64_t time = 0;
+    for (int i = 0; i < 8; ++i) {
+      time |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+    }
+    std::memcpy(&record.Time, &time, sizeof(time));
+    return this->ReadVarint(record.Frame) &&
+      this->ReadVarint(record.GlobalFrame);
+  }
+}
+
+bool cmBinaryTraceReader::ReadHeader()
+{
+  char magic[sizeof(BinaryTraceMagic)];
+  if (!this->In.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, BinaryTraceMagic, sizeof(magic)) != 0) {
+    return this->Fail("not a binary-v1 trace file");
+  }
+  std::uint64_t major;
+  std::uint64_t minor;
+  if (!this->ReadVarint(major) || !this->ReadVarint(minor)) {
+    return false;
+  }
+  if (major != BinaryTraceMajor) {
+    return this->Fail(cmStrCat("unsupported trace version ", major, '.',
+                               minor));
+  }
+  return true;
+}
+
+bool cmBinaryTraceReader::ReadVarint(std::uint64_t& value)
+{
+  value = 0;
+  for (unsigned int shift = 0; shift < 64; shift += 7) {
+    int const c = this->In.get();
+    if (c == std::char_traits<char>::eof()) {
+      return this->Fail("unexpected end of file");
+    }
+    value |= static_cast<std::uint64_t>(c & 0x7f) << shift;
+    if (!(c & 0x80)) {
+      return true;
+    }
+  }
+  return this->Fail("invalid integer encoding");
+}
+
+bool cmBinaryTraceReader::ReadString(std::string& value)
+{
+  std::uint64_t size;
+  if (!this->ReadVarint(size)) {
+    return false;
+  }
+  value.clear();
+  // Read in bounded chunks so a corrupt size cannot allocate unbounded
+  // memory before hitting the end of the file.
+  char chunk[4096];
+  while (size > 0) {
+    std::streamsize const n = static_cast<std::streamsize>(
+      size < sizeof(chunk) ? size : sizeof(chunk));
+    if (!this->In.read(chunk, n)) {
+      return this->Fail("unexpected end of file");
+    }
+    value.append(chunk, static_cast<std::string::size_type>(n));
+    size -= static_cast<std::uint64_t>(n);
+  }
+  return true;
+}
+
+bool cmBinaryTraceReader::ReadStringRef(std::string& value)
+{
+  std::uint64_t index;
+  if (!this->ReadVarint(index)) {
+    return false;
+  }
+  if (index >= this->Strings.size()) {
+    return this->Fail("invalid string reference");
+  }
+  value = this->Strings[index];
+  return true;
+}
+
+bool cmBinaryTraceReader::Fail(std::string message)
+{
+  this->Error = std::move(message);
+  return false;
+}
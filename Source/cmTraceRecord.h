@@ -0,0 +1,106 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cm/optional>
+#include <cm/string_view>
+
+/** \class cmTraceRecord
+ * \brief One command invocation reported by --trace.
+ *
+ * The same record is rendered as human-readable text, as a json-v1 line,
+ * or encoded into the binary-v1 format by cmBinaryTraceWriter.
+ */
+struct cmTraceRecord
+{
+  std::string File;
+  long Line = 0;
+  long LineEnd = 0;
+  cm::optional<std::string> DeferId;
+  std::string Command;
+  std::vector<std::string> Args;
+  double Time = 0;
+  std::uint64_t Frame = 0;
+  std::uint64_t GlobalFrame = 0;
+
+  /** Format the record the way --trace-format=human prints it.  */
+  std::string ToHuman() const;
+
+#ifndef CMAKE_BOOTSTRAP
+  /** Format the record as one line of --trace-format=json-v1 output.  */
+  std::string ToJSON() const;
+
+  /** The version line that starts --trace-format=json-v1 output.  */
+  static std::string JSONVersion();
+#endif
+
+  /** Return true if the file at \a path was selected by one of the
+      --trace-source values in \a sources, or if \a sources is empty.  */
+  static bool MatchesSource(std::string const& path,
+                            std::vector<std::string> const& sources);
+};
+
+/** \class cmBinaryTraceWriter
+ * \brief Write --trace-format=binary-v1 records to a stream.
+ *
+ * File paths, command names and deferral ids repeat in nearly every
+ * record, so each distinct string is written once and referenced by its
+ * index afterwards.  Output is collected in a buffer and handed to the
+ * stream in large blocks.
+ */
+class cmBinaryTraceWriter
+{
+public:
+  cmBinaryTraceWriter(std::ostream& out);
+  ~cmBinaryTraceWriter();
+
+  cmBinaryTraceWriter(cmBinaryTraceWriter const&) = delete;
+  cmBinaryTraceWriter& operator=(cmBinaryTraceWriter const&) = delete;
+
+  void Write(cmTraceRecord const& record);
+  void Flush();
+
+private:
+  std::uint64_t Intern(std::string const& value);
+  void WriteVarint(std::uint64_t value);
+  void WriteString(cm::string_view value);
+
+  std::ostream& Out;
+  std::string Buffer;
+  std::unordered_map<std::string, std::uint64_t> Strings;
+};
+
+/** \class cmBinaryTraceReader
+ * \brief Read records written by cmBinaryTraceWriter.
+ */
+class cmBinaryTraceReader
+{
+public:
+  cmBinaryTraceReader(std::istream& in);
+
+  /** Read the next record.  Returns false at the end of the trace or on
+      error, in which case GetError() is not empty.  */
+  bool Read(cmTraceRecord& record);
+
+  std::string const& GetError() const { return this->Error; }
+
+private:
+  bool ReadHeader();
+  bool ReadVarint(std::uint64_t& value);
+  bool ReadString(std::string& value);
+  bool ReadStringRef(std::string& value);
+  bool Fail(std::string message);
+
+  std::istream& In;
+  bool HeaderRead = false;
+  std::vector<std::string> Strings;
+  std::string Error;
+};
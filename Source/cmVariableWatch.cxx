@@ -62,6 +62,11 @@ void cmVariableWatch::RemoveWatch(std::string const& variable,
   }
 }
 
+bool cmVariableWatch::IsWatched(std::string const& variable) const
+{
+  return this->WatchMap.find(variable) != this->WatchMap.end();
+}
+
 bool cmVariableWatch::VariableAccessed(std::string const& variable,
                                        AccessType accessType,
                                        char const* newValue,
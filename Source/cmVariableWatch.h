@@ -47,6 +47,11 @@ public:
   void RemoveWatch(std::string const& variable, WatchMethod method,
                    void* client_data = nullptr);
 
+  /**
+   * Return whether any watch is registered for the variable
+   */
+  bool IsWatched(std::string const& variable) const;
+
   /**
    * This method is called when variable is accessed
    */
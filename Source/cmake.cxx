@@ -63,6 +63,7 @@
 #include "cmSystemTools.h"
 #include "cmTarget.h"
 #include "cmTargetLinkLibraryType.h"
+#include "cmTraceRecord.h"
 #include "cmUVProcessChain.h"
 #include "cmUtils.hxx"
 #include "cmVersionConfig.h"
@@ -92,6 +93,7 @@
 #  include "cmInstrumentationInterrupt.h"
 #  include "cmInstrumentationQuery.h"
 #  include "cmMakefileProfilingData.h"
+#  include "cmMemoryReport.h"
 #  include "cmVariableWatch.h"
 #endif
 
@@ -1289,7 +1291,8 @@ void cmake::SetArgs(std::vector<std::string> const& args)
         auto const traceFormat = StringToTraceFormat(value);
         if (traceFormat == TraceFormat::Undefined) {
           cmSystemTools::Error("Invalid format specified for --trace-format. "
-                               "Valid formats are human, json-v1.");
+                               "Valid formats are human, json-v1, "
+                               "binary-v1.");
           return false;
         }
         state->SetTraceFormat(traceFormat);
@@ -1445,6 +1448,14 @@ void cmake::SetArgs(std::vector<std::string> const& args)
       profilingOutput = cmSystemTools::ToNormalizedPathOnDisk(value);
       return true;
     });
+  arguments.emplace_back(
+    "--memory-report", "No file specified for --memory-report",
+    CommandArgument::Values::One,
+    [](std::string const& value, cmake* state) -> bool {
+      state->MemoryReport = cm::make_unique<cmMemoryReport>(
+        cmSystemTools::ToNormalizedPathOnDisk(value));
+      return true;
+    });
   arguments.emplace_back("--preset", "No preset specified for --preset",
                          CommandArgument::Values::One,
                          [&](std::string const& value, cmake*) -> bool {
@@ -1684,6 +1695,7 @@ cmake::TraceFormat cmake::StringToTraceFormat(std::string const& traceStr)
   static std::vector<TracePair> const levels = {
     { "human", TraceFormat::Human },
     { "json-v1", TraceFormat::JSONv1 },
+    { "binary-v1", TraceFormat::BinaryV1 },
   };
 
   auto const traceStrLowCase = cmSystemTools::LowerCase(traceStr);
@@ -1707,7 +1719,9 @@ bool cmake::PopTraceCmd()
 
 void cmake::SetTraceFile(std::string const& file)
 {
+  this->BinaryTraceWriter.reset();
   this->TraceFile.close();
+  this->TraceFilePath = file;
   this->TraceFile.open(file.c_str());
   if (!this->TraceFile) {
     cmSystemTools::Error(cmStrCat("Error opening trace file ", file, ": ",
@@ -1728,17 +1742,18 @@ void cmake::PrintTraceFormatVersion()
   switch (this->GetTraceFormat()) {
     case TraceFormat::JSONv1: {
 #ifndef CMAKE_BOOTSTRAP
-      Json::Value val;
-      Json::Value version;
-      Json::StreamWriterBuilder builder;
-      builder["indentation"] = "";
-      version["major"] = 1;
-      version["minor"] = 2;
-      val["version"] = version;
-      msg = Json::writeString(builder, val);
+      msg = cmTraceRecord::JSONVersion();
 #endif
       break;
     }
+    case TraceFormat::BinaryV1:
+      // The binary format carries its own header.  It cannot be mixed
+      // with the text printed to stderr, so it requires a trace file.
+      if (!this->GetBinaryTraceWriter()) {
+        cmSystemTools::Error("--trace-format=binary-v1 requires "
+                             "--trace-redirect.");
+      }
+      break;
     case TraceFormat::Human:
       msg = "";
       break;
@@ -1759,6 +1774,30 @@ void cmake::PrintTraceFormatVersion()
   }
 }
 
+cmBinaryTraceWriter* cmake::GetBinaryTraceWriter()
+{
+  if (this->TraceRedirect) {
+    return this->TraceRedirect->GetBinaryTraceWriter();
+  }
+  if (!this->BinaryTraceWriter &&
+      this->TraceFormatVar == TraceFormat::BinaryV1 && this->TraceFile) {
+    // Nothing has been written yet.  Reopen the file in binary mode so
+    // that line endings are not translated.
+    this->TraceFile.close();
+    this->TraceFile.open(this->TraceFilePath.c_str(),
+                         std::ios::out | std::ios::binary);
+    if (!this->TraceFile) {
+      cmSystemTools::Error(cmStrCat("Error opening trace file ",
+                                    this->TraceFilePath, ": ",
+                                    cmSystemTools::GetLastSystemError()));
+      return nullptr;
+    }
+    this->BinaryTraceWriter =
+      cm::make_unique<cmBinaryTraceWriter>(this->TraceFile);
+  }
+  return this->BinaryTraceWriter.get();
+}
+
 void cmake::SetTraceRedirect(cmake* other)
 {
   this->Trace = other->Trace;
@@ -2532,6 +2571,11 @@ int cmake::Configure()
   if (!delCacheVars.empty()) {
     return this->HandleDeleteCacheVariables(delCacheVars);
   }
+#if !defined(CMAKE_BOOTSTRAP)
+  if (ret == 0 && this->MemoryReport && this->GlobalGenerator) {
+    this->MemoryReport->WritePhase("configure", *this->GlobalGenerator);
+  }
+#endif
   return ret;
 }
 
@@ -3249,6 +3293,9 @@ int cmake::Generate()
   this->SaveCache(this->GetHomeOutputDirectory());
 
 #if !defined(CMAKE_BOOTSTRAP)
+  if (this->MemoryReport) {
+    this->MemoryReport->WritePhase("generate", *this->GlobalGenerator);
+  }
   this->GlobalGenerator->WriteInstallJson();
   this->FileAPI->WriteReplies(cmFileAPI::IndexFor::Success);
   this->Instrumentation->CollectTimingData(
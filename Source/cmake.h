@@ -48,6 +48,7 @@ class cmDebuggerAdapter;
 }
 #endif
 
+class cmBinaryTraceWriter;
 class cmExternalMakefileProjectGeneratorFactory;
 class cmCMakePresetsArgs;
 class cmCMakePresetsConfigureArgs;
@@ -57,6 +58,7 @@ class cmInstrumentation;
 class cmFileTimeCache;
 class cmGlobalGenerator;
 class cmMakefile;
+class cmMemoryReport;
 class cmMessenger;
 class cmVariableWatch;
 class cmGlobalGeneratorFactory;
@@ -547,6 +549,8 @@ public:
     }
     return this->TraceFile;
   }
+  //! Writer for --trace-format=binary-v1, if that format is active.
+  cmBinaryTraceWriter* GetBinaryTraceWriter();
   void SetTraceFile(std::string const& file);
   void PrintTraceFormatVersion();
 
@@ -770,6 +774,9 @@ private:
   bool TraceExpand = false;
   TraceFormat TraceFormatVar = TraceFormat::Human;
   cmGeneratedFileStream TraceFile;
+  std::string TraceFilePath;
+  // Declared after TraceFile so it is flushed before the file closes.
+  std::unique_ptr<cmBinaryTraceWriter> BinaryTraceWriter;
   cmake* TraceRedirect = nullptr;
 #ifndef CMAKE_BOOTSTRAP
   std::unique_ptr<cmConfigureLog> ConfigureLog;
@@ -874,6 +881,7 @@ private:
 
 #if !defined(CMAKE_BOOTSTRAP)
   std::unique_ptr<cmMakefileProfilingData> ProfilingOutput;
+  std::unique_ptr<cmMemoryReport> MemoryReport;
 #endif
 
 #ifdef CMake_ENABLE_DEBUGGER
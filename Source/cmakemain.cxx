@@ -135,7 +135,9 @@ cmDocumentationEntry const cmDocumentationOptions[] = {
     "google-trace" },
   { "--profiling-output=<file>",
     "Select an output path for the profiling data enabled through "
-    "--profiling-format." }
+    "--profiling-format." },
+  { "--memory-report=<file>",
+    "Write estimated memory use of the project to a JSON file." }
 };
 
 #endif
@@ -35,6 +35,7 @@
 #include "cmStdIoTerminal.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
+#include "cmTraceRecord.h"
 #include "cmTransformDepfile.h"
 #include "cmUVProcessChain.h"
 #include "cmUVStream.h"
@@ -107,6 +108,8 @@ char const* const HELP_AVAILABLE_COMMANDS = R"(Available commands:
   chdir dir cmd [args...]   - run command in a given directory
   compare_files [--ignore-eol] file1 file2
                             - check if file1 is same as file2
+  convert_trace [--format=<fmt>] [--file=<file>]... [--command=<cmd>]... <trace>
+                            - print a binary-v1 trace file as human or json-v1
   copy <file>... destination | -t <destination> <file>...
                             - copy files to destination (either file or directory)
   copy_directory <dir>... destination | -t <destination> <dir>...
@@ -131,6 +134,7 @@ char const* const HELP_AVAILABLE_COMMANDS = R"(Available commands:
   sha256sum <file>...       - create SHA256 checksum of files
   sha384sum <file>...       - create SHA384 checksum of files
   sha512sum <file>...       - create SHA512 checksum of files
+  rapidhashsum <file>...    - create RAPIDHASH checksum of files
   remove [-f] <file>...     - remove the file(s), use -f to force it (deprecated: use rm instead)
   remove_directory <dir>... - remove directories and their contents (deprecated: use rm instead)
   rename oldname newname    - rename a file or directory (on one volume)
@@ -1561,6 +1565,17 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string> const& args,
       return HashSumFile(args, cmCryptoHash::AlgoSHA512);
     }
 
+    if (args[1] == "rapidhashsum" && args.size() >= 3) {
+      return HashSumFile(args, cmCryptoHash::AlgoRAPIDHASH);
+    }
+
+#ifndef CMAKE_BOOTSTRAP
+    // Command to print a binary trace in a text format
+    if (args[1] == "convert_trace" && args.size() >= 3) {
+      return cmcmd::ConvertTrace(args);
+    }
+#endif
+
     // Command to concat files into one
     if (args[1] == "cat") {
       if (args.size() == 2) {
@@ -2474,6 +2489,71 @@ int cmcmd::HashSumFile(std::vector<std::string> const& args,
   return retval;
 }
 
+#ifndef CMAKE_BOOTSTRAP
+int cmcmd::ConvertTrace(std::vector<std::string> const& args)
+{
+  bool json = true;
+  std::vector<std::string> files;
+  std::vector<std::string> commands;
+  std::string traceFile;
+  for (auto const& arg : cmMakeRange(args).advance(2)) {
+    if (cmHasLiteralPrefix(arg, "--format=")) {
+      std::string const format = arg.substr(9);
+      if (format == "json-v1") {
+        json = true;
+      } else if (format == "human") {
+        json = false;
+      } else {
+        std::cerr << "convert_trace: unknown format \"" << format
+                  << "\".  Valid formats are human, json-v1.\n";
+        return 1;
+      }
+    } else if (cmHasLiteralPrefix(arg, "--file=")) {
+      files.emplace_back(arg.substr(7));
+    } else if (cmHasLiteralPrefix(arg, "--command=")) {
+      commands.emplace_back(cmSystemTools::LowerCase(arg.substr(10)));
+    } else if (traceFile.empty() && !cmHasPrefix(arg, '-')) {
+      traceFile = arg;
+    } else {
+      std::cerr << "convert_trace: unexpected argument \"" << arg << "\"\n";
+      return 1;
+    }
+  }
+  if (traceFile.empty()) {
+    std::cerr << "convert_trace: no trace file given\n";
+    return 1;
+  }
+
+  cmsys::ifstream fin(traceFile.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    std::cerr << "convert_trace: cannot open \"" << traceFile << "\"\n";
+    return 1;
+  }
+
+  if (json) {
+    std::cout << cmTraceRecord::JSONVersion() << '\n';
+  }
+  cmBinaryTraceReader reader(fin);
+  cmTraceRecord record;
+  while (reader.Read(record)) {
+    if (!cmTraceRecord::MatchesSource(record.File, files)) {
+      continue;
+    }
+    if (!commands.empty() &&
+        !cm::contains(commands, cmSystemTools::LowerCase(record.Command))) {
+      continue;
+    }
+    std::cout << (json ? record.ToJSON() : record.ToHuman()) << '\n';
+  }
+  if (!reader.GetError().empty()) {
+    std::cerr << "convert_trace: " << traceFile << ": " << reader.GetError()
+              << '\n';
+    return 1;
+  }
+  return 0;
+}
+#endif
+
 int cmcmd::SymlinkLibrary(std::vector<std::string> const& args)
 {
   int result = 0;
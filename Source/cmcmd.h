@@ -33,6 +33,7 @@ protected:
   static int HandleCoCompileCommands(std::vector<std::string> const& args);
   static int HashSumFile(std::vector<std::string> const& args,
                          cmCryptoHash::Algo algo);
+  static int ConvertTrace(std::vector<std::string> const& args);
   static int SymlinkLibrary(std::vector<std::string> const& args);
   static int SymlinkExecutable(std::vector<std::string> const& args);
   static cmsys::Status SymlinkInternal(std::string const& file,
@@ -84,5 +84,30 @@ int testGeneratedFileStream(int /*unused*/, char* /*unused*/[])
   cmSystemTools::RemoveFile(file3tmp);
   cmSystemTools::RemoveFile(file4tmp);
 
+  // Copy-if-different output too large to be held in memory is streamed
+  // to the temporary file, and is still compared with the existing file.
+  std::string const fileLarge = "generatedFileLarge";
+  std::string const line(1023, 'x');
+  cmSystemTools::RemoveFile(fileLarge);
+  for (int pass = 0; pass < 2; ++pass) {
+    cmGeneratedFileStream fout(fileLarge);
+    fout.SetCopyIfDifferent(true);
+    for (int i = 0; i < 20 * 1024; ++i) {
+      fout << line << '\n';
+    }
+    bool const replaced = fout.Close();
+    if (replaced != (pass == 0)) {
+      cmFailed("Something wrong with cmGeneratedFileStream. Wrong "
+               "copy-if-different result for large file: ",
+               fileLarge.c_str());
+    }
+  }
+  if (cmSystemTools::FileLength(fileLarge) != 20 * 1024 * 1024) {
+    cmFailed("Something wrong with cmGeneratedFileStream. Wrong size of "
+             "large file: ",
+             fileLarge.c_str());
+  }
+  cmSystemTools::RemoveFile(fileLarge);
+
   return failed;
 }
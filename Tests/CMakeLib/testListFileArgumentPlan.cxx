@@ -0,0 +1,181 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <cm/memory>
+
+#include "cmExecutionStatus.h"
+#include "cmGlobalGenerator.h"
+#include "cmList.h"
+#include "cmListFileCache.h"
+#include "cmMakefile.h"
+#include "cmState.h"
+#include "cmStateDirectory.h"
+#include "cmStateSnapshot.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+#include "cmake.h"
+
+#include "testCommon.h"
+
+namespace {
+struct Fixture
+{
+  cmake CMake{ cmState::Role::Project };
+  std::unique_ptr<cmGlobalGenerator> GG;
+  std::unique_ptr<cmMakefile> MF;
+  int Checked = 0;
+  bool Failed = false;
+
+  Fixture()
+  {
+    this->GG = cm::make_unique<cmGlobalGenerator>(&this->CMake);
+    cmStateSnapshot snapshot = this->CMake.GetCurrentSnapshot();
+    snapshot.GetDirectory().SetCurrentBinary(".");
+    snapshot.GetDirectory().SetCurrentSource(".");
+    this->MF = cm::make_unique<cmMakefile>(this->GG.get(), snapshot);
+
+    // Compare each argument of check() with the expansion done without
+    // an expansion plan.
+    this->CMake.GetState()->AddBuiltinCommand(
+      "check",
+      [this](std::vector<cmListFileArgument> const& args,
+             cmExecutionStatus& status) -> bool {
+        this->Check(args, status.GetMakefile());
+        return true;
+      });
+  }
+
+  static std::vector<std::string> ExpandWithoutPlan(
+    cmMakefile const& mf, std::vector<cmListFileArgument> const& args)
+  {
+    std::vector<std::string> out;
+    std::string const& filename = mf.GetBacktrace().Top().FilePath;
+    for (cmListFileArgument const& arg : args) {
+      if (arg.Delim == cmListFileArgument::Bracket) {
+        out.push_back(arg.Value);
+        continue;
+      }
+      std::string value = arg.Value;
+      mf.ExpandVariablesInString(value, false, false, false, filename.c_str(),
+                                 arg.Line, false, false);
+      if (arg.Delim == cmListFileArgument::Quoted) {
+        out.push_back(value);
+      } else {
+        cmExpandList(value, out);
+      }
+    }
+    return out;
+  }
+
+  void Check(std::vector<cmListFileArgument> const& args,
+             cmMakefile const& mf)
+  {
+    std::vector<std::string> const expected = ExpandWithoutPlan(mf, args);
+    // Expand twice so that the second expansion uses the cached plans.
+    for (int pass = 0; pass < 2; ++pass) {
+      std::vector<std::string> actual;
+      mf.ExpandArguments(args, actual);
+      if (actual != expected) {
+        std::cout << "Expansion pass " << pass << " of line "
+                  << args.front().Line << " gives '" << cmJoin(actual, "|")
+                  << "', expected '" << cmJoin(expected, "|") << "'\n";
+        this->Failed = true;
+      }
+    }
+    ++this->Checked;
+  }
+
+  bool Run(std::string const& content)
+  {
+    return this->MF->ReadListFileAsString(content, "test.cmake");
+  }
+};
+
+cmListFileArgumentPlan::PlanKind PlanKind(std::string const& value,
+                                          cmListFileArgument::Delimiter delim)
+{
+  cmListFileArgument const arg(value, delim, 1);
+  return arg.GetExpansionPlan().Kind;
+}
+}
+
+static bool testPlanKinds()
+{
+  std::cout << "testPlanKinds()\n";
+
+  using Plan = cmListFileArgumentPlan;
+  using Arg = cmListFileArgument;
+  ASSERT_TRUE(PlanKind("abc", Arg::Unquoted) == Plan::Literal);
+  ASSERT_TRUE(PlanKind("", Arg::Quoted) == Plan::Literal);
+  ASSERT_TRUE(PlanKind("$<CONFIG>$", Arg::Unquoted) == Plan::Literal);
+  ASSERT_TRUE(PlanKind("${A}", Arg::Bracket) == Plan::Literal);
+  ASSERT_TRUE(PlanKind("a${A}b", Arg::Unquoted) == Plan::Template);
+  ASSERT_TRUE(PlanKind("$ENV{E}$CACHE{C}", Arg::Quoted) == Plan::Template);
+  ASSERT_TRUE(PlanKind("a\\;b", Arg::Unquoted) == Plan::General);
+  ASSERT_TRUE(PlanKind("${${A}}", Arg::Quoted) == Plan::General);
+  ASSERT_TRUE(PlanKind("${A", Arg::Quoted) == Plan::General);
+  ASSERT_TRUE(PlanKind("${}", Arg::Quoted) == Plan::General);
+  ASSERT_TRUE(PlanKind("${CMAKE_CURRENT_LIST_LINE}", Arg::Quoted) ==
+              Plan::General);
+
+  // A plan is built once and shared by later copies of the argument.
+  Arg const arg("${A}", Arg::Unquoted, 1);
+  cmListFileArgumentPlan const& plan = arg.GetExpansionPlan();
+  Arg const copy = arg;
+  ASSERT_TRUE(&copy.GetExpansionPlan() == &plan);
+  return true;
+}
+
+static bool testExpansion()
+{
+  std::cout << "testExpansion()\n";
+
+  Fixture fx;
+  cmSystemTools::PutEnv("TEST_PLAN_ENV=e1;e2");
+  ASSERT_TRUE(fx.Run(R"(
+set(A a)
+set(L "x;y")
+set(E "")
+set(LE "x;;y;")
+set(N A)
+set(CACHE_VAR "c1;c2" CACHE STRING "")
+
+# Unquoted arguments are split on ';' and drop empty elements.
+check(abc a;b a;;b ;a; ${A} x${A}y ${L} a${L}b ${E} ${LE} ;${L};)
+check(${A}${L}${A} ${UNDEFINED} x${UNDEFINED}y)
+
+# Quoted arguments are not split and keep empty values.
+check("abc" "a;b" "" "${A}" "x${L}y" "${E}" "${LE}" "${UNDEFINED}")
+
+# Bracket arguments are not expanded.
+check([[${A}]] [=[a;b]=] [[]])
+
+# Environment and cache references.
+check($ENV{TEST_PLAN_ENV} "$ENV{TEST_PLAN_ENV}" $ENV{TEST_PLAN_UNSET})
+check($CACHE{CACHE_VAR} "$CACHE{CACHE_VAR}" "$CACHE{A}")
+
+# Arguments left to the general expansion code.
+check(a\;b "a\;b" "\${A}" ${${N}} "${${N}}" "${CMAKE_CURRENT_LIST_LINE}")
+check($ $$ "$<CONFIG>" a$<CONFIG>${A} "@A@" @A@)
+
+# Re-running the same argument with different values.
+foreach(A IN ITEMS 1 "2;3" "")
+  check(${A} "${A}" x${A}y)
+endforeach()
+)"));
+  cmSystemTools::UnsetEnv("TEST_PLAN_ENV");
+  ASSERT_TRUE(!fx.Failed);
+  ASSERT_EQUAL(fx.Checked, 11);
+  return true;
+}
+
+int testListFileArgumentPlan(int /*unused*/, char* /*unused*/[])
+{
+  return runTests({
+    testPlanKinds,
+    testExpansion,
+  });
+}
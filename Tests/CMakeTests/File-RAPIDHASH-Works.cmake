@@ -0,0 +1,2 @@
+file(RAPIDHASH ${CMAKE_CURRENT_LIST_DIR}/File-HASH-Input.txt rapidhash)
+message("${rapidhash}")
@@ -0,0 +1,2 @@
+string(RAPIDHASH rapidhash "sample input string\n")
+message("${rapidhash}")
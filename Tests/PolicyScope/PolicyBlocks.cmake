@@ -0,0 +1,38 @@
+# Included with CMP0174 set to policy_blocks_inherited.  The include
+# and each block() push a policy scope that inherits the enclosing
+# settings.  Flip CMP0174 at every level and check that each endblock()
+# restores it.
+if(policy_blocks_inherited STREQUAL "OLD")
+  set(policy_blocks_flipped NEW)
+else()
+  set(policy_blocks_flipped OLD)
+endif()
+
+cmake_policy(GET CMP0174 cmp)
+check("CMP0174 in include" "${policy_blocks_inherited}" "${cmp}")
+block(SCOPE_FOR POLICIES)
+  cmake_policy(GET CMP0174 cmp)
+  check("CMP0174 in block 1" "${policy_blocks_inherited}" "${cmp}")
+  cmake_policy(SET CMP0174 ${policy_blocks_flipped})
+  block(SCOPE_FOR POLICIES)
+    cmake_policy(GET CMP0174 cmp)
+    check("CMP0174 in block 2" "${policy_blocks_flipped}" "${cmp}")
+    cmake_policy(SET CMP0174 ${policy_blocks_inherited})
+    block(SCOPE_FOR POLICIES)
+      cmake_policy(GET CMP0174 cmp)
+      check("CMP0174 in block 3" "${policy_blocks_inherited}" "${cmp}")
+      cmake_policy(SET CMP0174 ${policy_blocks_flipped})
+      cmake_policy(GET CMP0174 cmp)
+      check("CMP0174 set in block 3" "${policy_blocks_flipped}" "${cmp}")
+    endblock()
+    cmake_policy(GET CMP0174 cmp)
+    check("CMP0174 after block 3" "${policy_blocks_inherited}" "${cmp}")
+  endblock()
+  cmake_policy(GET CMP0174 cmp)
+  check("CMP0174 after block 2" "${policy_blocks_flipped}" "${cmp}")
+endblock()
+cmake_policy(GET CMP0174 cmp)
+check("CMP0174 after block 1" "${policy_blocks_inherited}" "${cmp}")
+
+# The includer checks that this is undone when the include returns.
+cmake_policy(SET CMP0174 ${policy_blocks_flipped})
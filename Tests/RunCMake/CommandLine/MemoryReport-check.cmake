@@ -0,0 +1,55 @@
+if(NOT EXISTS "${MemoryReportOutput}")
+  set(RunCMake_TEST_FAILED "Expected ${MemoryReportOutput} to exist")
+  return()
+endif()
+
+file(READ "${MemoryReportOutput}" json)
+string(JSON major GET "${json}" version major)
+if(NOT major EQUAL 1)
+  set(RunCMake_TEST_FAILED "Unexpected version major '${major}'")
+  return()
+endif()
+
+foreach(phase IN ITEMS configure generate)
+  foreach(category IN ITEMS directories targets sourceFiles variables cacheEntries backtraces)
+    string(JSON count ERROR_VARIABLE err GET "${json}" ${phase} categories ${category} count)
+    if(err OR NOT count GREATER 0)
+      set(RunCMake_TEST_FAILED "Expected ${phase} ${category} count, got '${count}' ${err}")
+      return()
+    endif()
+  endforeach()
+
+  # The largest targets are listed in decreasing size and include ours.
+  string(JSON n LENGTH "${json}" ${phase} largestTargets)
+  math(EXPR last "${n} - 1")
+  set(found 0)
+  set(previous "")
+  foreach(i RANGE ${last})
+    string(JSON name GET "${json}" ${phase} largestTargets ${i} name)
+    string(JSON bytes GET "${json}" ${phase} largestTargets ${i} bytes)
+    if(NOT previous STREQUAL "" AND bytes GREATER previous)
+      set(RunCMake_TEST_FAILED "Expected ${phase} largest targets in decreasing size")
+      return()
+    endif()
+    set(previous "${bytes}")
+    if(name STREQUAL "memory_report_target" AND bytes GREATER 0)
+      set(found 1)
+    endif()
+  endforeach()
+  if(NOT found)
+    set(RunCMake_TEST_FAILED "Expected memory_report_target in ${phase} largest targets")
+    return()
+  endif()
+
+  # Variables the subdirectory inherits are counted once.
+  string(JSON variables GET "${json}" ${phase} categories variables count)
+  set(visible 0)
+  foreach(i RANGE 1)
+    string(JSON dirVariables GET "${json}" ${phase} largestDirectories ${i} variables)
+    math(EXPR visible "${visible} + ${dirVariables}")
+  endforeach()
+  if(NOT variables LESS visible)
+    set(RunCMake_TEST_FAILED "Expected ${phase} variables count ${variables} to be less than the ${visible} visible in both directories")
+    return()
+  endif()
+endforeach()
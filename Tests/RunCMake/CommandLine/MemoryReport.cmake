@@ -0,0 +1,7 @@
+add_custom_target(memory_report_target)
+set_property(TARGET memory_report_target PROPERTY LABELS one two three)
+set_source_files_properties(memory_report.c PROPERTIES LABELS four)
+
+# Variables inherited by a subdirectory share their values.
+set(memory_report_variable "value")
+add_subdirectory(MemoryReport)
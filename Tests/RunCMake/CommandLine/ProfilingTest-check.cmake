@@ -17,6 +17,34 @@ if (NOT JSON_TRAILER MATCHES "^}]$")
   return()
 endif()
 
+file(READ "${ProfilingTestOutput}" json)
+string(JSON n LENGTH "${json}")
+math(EXPR last "${n} - 1")
+math(EXPR path "${n} - 2")
+math(EXPR regex "${n} - 3")
+string(JSON name GET "${json}" ${regex} name)
+string(JSON hits GET "${json}" ${regex} args hits)
+if (NOT name STREQUAL "regex cache" OR hits LESS 3)
+  set(RunCMake_TEST_FAILED
+      "Expected regex cache counters near the end, got name='${name}' hits='${hits}'")
+  return()
+endif()
+string(JSON name GET "${json}" ${path} name)
+string(JSON misses GET "${json}" ${path} args misses)
+if (NOT name STREQUAL "path cache" OR misses LESS 1)
+  set(RunCMake_TEST_FAILED
+      "Expected path cache counters near the end, got name='${name}' misses='${misses}'")
+  return()
+endif()
+string(JSON name GET "${json}" ${last} name)
+string(JSON written GET "${json}" ${last} args written)
+string(JSON unchanged GET "${json}" ${last} args unchanged)
+if (NOT name STREQUAL "generated files" OR written LESS 1 OR NOT unchanged MATCHES "^[0-9]+$")
+  set(RunCMake_TEST_FAILED
+      "Expected generated files counters at the end, got name='${name}' written='${written}'")
+  return()
+endif()
+
 file(STRINGS ${ProfilingTestOutput} upperCaseCommand
   REGEX [["name"[ ]*:[ ]*"__TESTING_COMMAND_CASE"]])
 if (NOT "${upperCaseCommand}" STREQUAL "")
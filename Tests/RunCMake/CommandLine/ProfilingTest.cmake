@@ -3,3 +3,9 @@ endfunction()
 
 # This must not appear in the profiling output as uppercase
 __TESTING_COMMAND_CASE()
+
+# Repeated patterns must hit the regex cache.
+foreach(i RANGE 3)
+  if(i MATCHES "^__profiling_regex_([0-9])$")
+  endif()
+endforeach()
@@ -984,6 +984,7 @@ run_cmake_command(E_sha224sum-dir ${CMAKE_COMMAND} -E sha224sum .)
 run_cmake_command(E_sha256sum-dir ${CMAKE_COMMAND} -E sha256sum .)
 run_cmake_command(E_sha384sum-dir ${CMAKE_COMMAND} -E sha384sum .)
 run_cmake_command(E_sha512sum-dir ${CMAKE_COMMAND} -E sha512sum .)
+run_cmake_command(E_rapidhashsum-dir ${CMAKE_COMMAND} -E rapidhashsum .)
 
 run_cmake_command(E_md5sum-no-file ${CMAKE_COMMAND} -E md5sum nonexisting)
 run_cmake_command(E_sha1sum-no-file ${CMAKE_COMMAND} -E sha1sum nonexisting)
@@ -991,6 +992,7 @@ run_cmake_command(E_sha224sum-no-file ${CMAKE_COMMAND} -E sha224sum nonexisting)
 run_cmake_command(E_sha256sum-no-file ${CMAKE_COMMAND} -E sha256sum nonexisting)
 run_cmake_command(E_sha384sum-no-file ${CMAKE_COMMAND} -E sha384sum nonexisting)
 run_cmake_command(E_sha512sum-no-file ${CMAKE_COMMAND} -E sha512sum nonexisting)
+run_cmake_command(E_rapidhashsum-no-file ${CMAKE_COMMAND} -E rapidhashsum nonexisting)
 
 file(WRITE "${RunCMake_BINARY_DIR}/dummy" "dummy")
 run_cmake_command(E_md5sum ${CMAKE_COMMAND} -E md5sum ../dummy)
@@ -1000,6 +1002,7 @@ run_cmake_command(E_sha224sum ${CMAKE_COMMAND} -E sha224sum ../dummy)
 run_cmake_command(E_sha256sum ${CMAKE_COMMAND} -E sha256sum ../dummy)
 run_cmake_command(E_sha384sum ${CMAKE_COMMAND} -E sha384sum ../dummy)
 run_cmake_command(E_sha512sum ${CMAKE_COMMAND} -E sha512sum ../dummy)
+run_cmake_command(E_rapidhashsum ${CMAKE_COMMAND} -E rapidhashsum ../dummy)
 block()
   set(RunCMake-stdin-file ${RunCMake_BINARY_DIR}/dummy)
   run_cmake_command(E_md5sum-stdin ${CMAKE_COMMAND} -E md5sum -)
@@ -1008,6 +1011,7 @@ block()
   run_cmake_command(E_sha256sum-stdin ${CMAKE_COMMAND} -E sha256sum -)
   run_cmake_command(E_sha384sum-stdin ${CMAKE_COMMAND} -E sha384sum -)
   run_cmake_command(E_sha512sum-stdin ${CMAKE_COMMAND} -E sha512sum -)
+  run_cmake_command(E_rapidhashsum-stdin ${CMAKE_COMMAND} -E rapidhashsum -)
 endblock()
 file(REMOVE "${RunCMake_BINARY_DIR}/dummy")
 
@@ -1174,6 +1178,16 @@ set(RunCMake_TEST_OPTIONS --trace-expand --trace-format=json-v1 --trace-redirect
 run_cmake(trace-json-v1-expand)
 unset(RunCMake_TEST_OPTIONS)
 
+set(RunCMake_TEST_OPTIONS --trace        --trace-format=binary-v1 --trace-redirect=${RunCMake_BINARY_DIR}/binary-v1.trace)
+set(RunCMake_TEST_VARIANT_DESCRIPTION "-binary-v1")
+run_cmake(trace-json-v1)
+unset(RunCMake_TEST_VARIANT_DESCRIPTION)
+unset(RunCMake_TEST_OPTIONS)
+
+set(RunCMake_TEST_OPTIONS --trace-format=binary-v1)
+run_cmake(trace-binary-v1-noredirect)
+unset(RunCMake_TEST_OPTIONS)
+
 set(RunCMake_TEST_OPTIONS --trace-source=trace-only-this-file.cmake)
 run_cmake(trace-source)
 unset(RunCMake_TEST_OPTIONS)
@@ -1270,6 +1284,13 @@ set(RunCMake_TEST_OPTIONS --profiling-format=google-trace --profiling-output=${P
 run_cmake(ProfilingTest)
 unset(RunCMake_TEST_OPTIONS)
 
+set(RunCMake_TEST_BINARY_DIR "${RunCMake_BINARY_DIR}/MemoryReport-build")
+set(MemoryReportOutput ${RunCMake_TEST_BINARY_DIR}/memory.json)
+set(RunCMake_TEST_OPTIONS --memory-report=${MemoryReportOutput})
+run_cmake(MemoryReport)
+unset(RunCMake_TEST_OPTIONS)
+unset(RunCMake_TEST_BINARY_DIR)
+
 run_cmake_with_options(help-arbitrary "--help" "CMAKE_CXX_IGNORE_EXTENSIONS")
 run_cmake_with_options(help-variable-lang "--help-variable" "CMAKE_CXX_PVS_STUDIO")
 
@@ -1,6 +1,40 @@
+set(trace_file "${RunCMake_BINARY_DIR}/json-v1.trace")
+if(RunCMake_TEST_VARIANT_DESCRIPTION STREQUAL "-binary-v1")
+  set(trace_file "${RunCMake_BINARY_DIR}/binary-v1-converted.trace")
+  execute_process(
+    COMMAND ${CMAKE_COMMAND} -E convert_trace "${RunCMake_BINARY_DIR}/binary-v1.trace"
+    OUTPUT_FILE "${trace_file}"
+    RESULT_VARIABLE result
+    ERROR_VARIABLE output
+    )
+  if(NOT result EQUAL 0)
+    set(RunCMake_TEST_FAILED "Converting binary trace failed:\n${output}")
+    return()
+  endif()
+
+  execute_process(
+    COMMAND ${CMAKE_COMMAND} -E convert_trace --format=human --command=SET
+            --file=trace-json-v1.cmake "${RunCMake_BINARY_DIR}/binary-v1.trace"
+    OUTPUT_VARIABLE output
+    RESULT_VARIABLE result
+    )
+  set(expect [[
+^[^
+]*/trace-json-v1\.cmake\(6\):  set\(ASDF fff sss   SPACES !!!   \)
+[^
+]*/trace-json-v1\.cmake\(7\):  set\(FOO 42 \)
+[^
+]*/trace-json-v1\.cmake\(8\):  set\(BAR  space in string! \)
+$]])
+  if(NOT result EQUAL 0 OR NOT output MATCHES "${expect}")
+    set(RunCMake_TEST_FAILED "Filtered binary trace is not as expected:\n${output}")
+    return()
+  endif()
+endif()
+
 if(Python_EXECUTABLE)
   execute_process(
-    COMMAND ${Python_EXECUTABLE} "${RunCMake_SOURCE_DIR}/trace-json-v1-check.py" "${RunCMake_BINARY_DIR}/json-v1.trace"
+    COMMAND ${Python_EXECUTABLE} "${RunCMake_SOURCE_DIR}/trace-json-v1-check.py" "${trace_file}"
     RESULT_VARIABLE result
     OUTPUT_VARIABLE output
     ERROR_VARIABLE output
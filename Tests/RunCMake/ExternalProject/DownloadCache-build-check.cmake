@@ -0,0 +1,10 @@
+string(REPEAT "D" 100 content)
+string(SHA256 hash "${content}")
+if(NOT EXISTS "${RunCMake_TEST_BINARY_DIR}/cache/SHA256/${hash}")
+  set(RunCMake_TEST_FAILED "Download was not added to the cache.")
+  return()
+endif()
+file(GLOB_RECURSE cached "${RunCMake_TEST_BINARY_DIR}/cached-prefix/src/test")
+if(NOT cached)
+  set(RunCMake_TEST_FAILED "Download was not satisfied from the cache.")
+endif()
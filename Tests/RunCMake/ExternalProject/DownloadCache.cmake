@@ -0,0 +1,27 @@
+include(ExternalProject)
+
+# The download server answers only one request with this content.
+set(CMAKE_DOWNLOAD_CACHE "${CMAKE_CURRENT_BINARY_DIR}/cache")
+string(REPEAT "D" 100 content)
+string(SHA256 hash "${content}")
+
+# Download the file and add it to the cache.
+ExternalProject_Add(fetch
+  URL ${SERVER_URL}
+  URL_HASH SHA256=${hash}
+  DOWNLOAD_NO_EXTRACT TRUE
+  CONFIGURE_COMMAND ""
+  BUILD_COMMAND ""
+  INSTALL_COMMAND ""
+  )
+
+# Satisfy the download from the cache without accessing the server again.
+ExternalProject_Add(cached
+  DEPENDS fetch
+  URL ${SERVER_URL}
+  URL_HASH SHA256=${hash}
+  DOWNLOAD_NO_EXTRACT TRUE
+  CONFIGURE_COMMAND ""
+  BUILD_COMMAND ""
+  INSTALL_COMMAND ""
+  )
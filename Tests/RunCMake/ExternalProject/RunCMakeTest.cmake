@@ -178,6 +178,7 @@ if(NOT RunCMake_GENERATOR MATCHES "Visual Studio")
   __ep_test_with_build(DownloadTimeout)
   __ep_test_with_build_with_server(DownloadInactivityTimeout --speed_limit --limit_duration 40)
   __ep_test_with_build_with_server(DownloadInactivityResume --speed_limit --limit_duration 1)
+  __ep_test_with_build_with_server(DownloadCache)
 endif()
 
 # We can't test the substitution when using the old MSYS due to
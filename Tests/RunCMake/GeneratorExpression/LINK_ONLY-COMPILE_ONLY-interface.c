@@ -0,0 +1,11 @@
+#ifndef COMPILEDEP
+#  error "COMPILEDEP not defined"
+#endif
+#ifdef LINKDEP
+#  error "LINKDEP defined"
+#endif
+
+int main(void)
+{
+  return 0;
+}
@@ -0,0 +1,23 @@
+enable_language(C)
+cmake_policy(SET CMP0099 NEW)
+cmake_policy(SET CMP0131 NEW)
+cmake_policy(SET CMP0166 NEW)
+
+add_library(compiledep INTERFACE)
+target_compile_definitions(compiledep INTERFACE COMPILEDEP)
+target_link_options(compiledep INTERFACE compiledep_must_not_link)
+add_library(linkdep INTERFACE)
+target_compile_definitions(linkdep INTERFACE LINKDEP)
+
+# The interface evaluates differently for compiling and for linking.
+add_library(iface INTERFACE)
+target_link_libraries(iface INTERFACE
+  "$<COMPILE_ONLY:compiledep>" "$<LINK_ONLY:linkdep>")
+add_library(mid INTERFACE)
+target_link_libraries(mid INTERFACE iface)
+
+# INTERFACE_LINK_LIBRARIES is transitive, so this evaluates that of
+# iface once for the usage requirements and once for linking.
+add_executable(consumer LINK_ONLY-COMPILE_ONLY-interface.c)
+target_link_libraries(consumer PRIVATE
+  "$<TARGET_PROPERTY:mid,INTERFACE_LINK_LIBRARIES>")
@@ -171,6 +171,10 @@ run_cmake(CONFIG-empty-entries)
 unset(RunCMake_TEST_OPTIONS)
 
 run_cmake_build_target(COMPILE_ONLY-custom-target-deps consumer)
+# CMP0189 is looked up where the link libraries are evaluated.
+set(RunCMake_TEST_OPTIONS -DCMAKE_POLICY_DEFAULT_CMP0189:STRING=NEW)
+run_cmake_build(LINK_ONLY-COMPILE_ONLY-interface)
+unset(RunCMake_TEST_OPTIONS)
 
 run_cmake_build_target(ListTransformApplyDependTarget consumer)
 
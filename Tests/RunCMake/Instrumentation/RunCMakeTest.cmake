@@ -28,6 +28,7 @@ function(instrument test)
     "COMPILE_TRACE_QUERY"
     "COMPILE_TRACE_QUERY_NULL"
     "TRACE_QUERY"
+    "CRITICAL_PATH_QUERY"
     "MANUAL_HOOK"
     "PRESERVE_DATA"
     "NO_CONFIGURE"
@@ -85,12 +86,17 @@ function(instrument test)
   if (ARGS_TRACE_QUERY)
     set(trace_query_hook_arg 1)
   endif()
+  set(critical_path_query_hook_arg 0)
+  if (ARGS_CRITICAL_PATH_QUERY)
+    set(critical_path_query_hook_arg 1)
+  endif()
   set(ARGS_COMPILE_TRACE_QUERY ${ARGS_COMPILE_TRACE_QUERY} PARENT_SCOPE)
   set(ARGS_COMPILE_TRACE_QUERY_NULL ${ARGS_COMPILE_TRACE_QUERY_NULL} PARENT_SCOPE)
   set(GET_HOOK
     "\\\"${CMAKE_COMMAND}\\\""
     "-DSTATIC_QUERY=${static_query_hook_arg}"
     "-DTRACE_QUERY=${trace_query_hook_arg}"
+    "-DCRITICAL_PATH_QUERY=${critical_path_query_hook_arg}"
     "-DPython_EXECUTABLE=${Python_EXECUTABLE}"
     "-DCMake_TEST_JSON_SCHEMA=${CMake_TEST_JSON_SCHEMA}"
     "-P \\\"${RunCMake_SOURCE_DIR}/hook.cmake\\\""
@@ -607,6 +613,11 @@ instrument(cmake-command-trace
   CHECK_SCRIPT check-trace-removed.cmake
 )
 
+instrument(cmake-command-critical-path
+  BUILD TRACE_QUERY CRITICAL_PATH_QUERY
+  CHECK_SCRIPT check-critical-path.cmake
+)
+
 instrument(cmake-command-long-output
   BUILD
   CONFIGURE_ARGS "-DLONG_CUSTOM_COMMAND_OUTPUT=ON"
@@ -0,0 +1,32 @@
+include(${CMAKE_CURRENT_LIST_DIR}/json.cmake)
+
+if (NOT EXISTS ${v1}/postCMakeBuild.hook)
+  add_error("postCMakeBuild hook did not run")
+endif()
+
+file(GLOB trace_files ${v1}/data/trace/trace-*.json)
+list(LENGTH trace_files n_trace_files)
+if (NOT n_trace_files EQUAL 1)
+  add_error("Found ${n_trace_files} trace files, expected 1.")
+else()
+  # The main executable depends on lib, so lib must precede it on the path.
+  read_json("${trace_files}" trace_contents)
+  string(JSON n_entries LENGTH "${trace_contents}")
+  math(EXPR entries_range "${n_entries}-1")
+  set(critical_path_targets)
+  foreach (i RANGE ${entries_range})
+    string(JSON cat GET "${trace_contents}" ${i} cat)
+    if (cat STREQUAL "criticalPath")
+      string(JSON name GET "${trace_contents}" ${i} args name)
+      list(APPEND critical_path_targets "${name}")
+    endif()
+  endforeach()
+  list(FIND critical_path_targets lib lib_index)
+  list(FIND critical_path_targets main main_index)
+  if (NOT critical_path_targets)
+    add_error("No critical path found in trace.")
+  elseif (lib_index GREATER_EQUAL 0 AND main_index GREATER_EQUAL 0 AND
+          NOT lib_index LESS main_index)
+    add_error("Unexpected critical path in trace: ${critical_path_targets}")
+  endif()
+endif()
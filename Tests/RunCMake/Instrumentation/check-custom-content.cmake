@@ -46,10 +46,12 @@ foreach(content_file IN LISTS content_files)
   string(JSON targetData GET "${targets}" lib)
   json_assert_key("${content_file}" "${targetData}" labels "\\[ \"label3\" \\]")
   json_assert_key("${content_file}" "${targetData}" type "STATIC_LIBRARY")
+  json_assert_key("${content_file}" "${targetData}" dependencies "\\[\\]")
 
   string(JSON targetData GET "${targets}" main)
   json_assert_key("${content_file}" "${targetData}" labels "\\[ \"label1\", \"label2\" \\]")
   json_assert_key("${content_file}" "${targetData}" type "EXECUTABLE")
+  json_assert_key("${content_file}" "${targetData}" dependencies "\\[ \"lib\" \\]")
 
 endforeach()
 
@@ -7,6 +7,7 @@ include(${CMAKE_CURRENT_LIST_DIR}/verify-trace.cmake)
 
 # Test CALLBACK script. Prints output information and verifies index file
 # Called as: cmake -P -DSTATIC_QUERY=<ON|OFF> -DTRACE_QUERY=<ON|OFF> \
+#            -DCRITICAL_PATH_QUERY=<ON|OFF> \
 #            -DCMake_TEST_JSON_SCHEMA=<ON|OFF> -DPython_EXECUTABLE=<path> \
 #            hook.cmake index-*.json
 
@@ -25,7 +26,7 @@ function(check_args vars)
     endif()
   endforeach()
 endfunction()
-check_args("STATIC_QUERY;TRACE_QUERY;Python_EXECUTABLE;CMake_TEST_JSON_SCHEMA")
+check_args("STATIC_QUERY;TRACE_QUERY;CRITICAL_PATH_QUERY;Python_EXECUTABLE;CMake_TEST_JSON_SCHEMA")
 
 function(init_query_var input_var output_var)
   set(${output_var})
@@ -36,6 +37,7 @@ function(init_query_var input_var output_var)
 endfunction()
 init_query_var(STATIC_QUERY hasStaticInfo)
 init_query_var(TRACE_QUERY hasTrace)
+init_query_var(CRITICAL_PATH_QUERY hasCriticalPath)
 
 cmake_path(GET index PARENT_PATH indexDir)
 cmake_path(GET indexDir PARENT_PATH dataDir)
@@ -84,6 +86,29 @@ foreach(i RANGE ${snippets_range})
   verify_snippet_file(${dataDir}/${filename} "${snippet_contents}")
 endforeach()
 
+set(n_critical_path_targets 0)
+json_has_key("${index}" "${contents}" criticalPath ${hasCriticalPath})
+if (NOT hasCriticalPath STREQUAL UNEXPECTED)
+  json_has_key("${index}" "${criticalPath}" duration)
+  set(critical_path_total "${duration}")
+  json_has_key("${index}" "${criticalPath}" targets)
+  string(JSON n_critical_path_targets LENGTH "${targets}")
+  set(critical_path_duration 0)
+  if (n_critical_path_targets GREATER 0)
+    math(EXPR critical_path_range "${n_critical_path_targets}-1")
+    foreach(i RANGE ${critical_path_range})
+      string(JSON target GET "${targets}" ${i})
+      json_has_key("${index}" "${target}" name)
+      json_has_key("${index}" "${target}" timeStart)
+      json_has_key("${index}" "${target}" duration)
+      math(EXPR critical_path_duration "${critical_path_duration}+${duration}")
+    endforeach()
+  endif()
+  if (NOT critical_path_duration EQUAL critical_path_total)
+    add_error("Critical path duration ${critical_path_total} is not the sum of its targets: ${critical_path_duration}")
+  endif()
+endif()
+
 json_has_key("${index}" "${contents}" trace ${hasTrace})
 if (NOT hasTrace STREQUAL UNEXPECTED)
   if (NOT EXISTS ${dataDir}/${trace})
@@ -95,13 +120,19 @@ if (NOT hasTrace STREQUAL UNEXPECTED)
   if (n_entries EQUAL 0)
     add_error("Listed trace file: ${dataDir}/${trace} has no entries")
   endif()
-  if (NOT n_entries EQUAL n_snippets)
-    add_error("Differing number of trace entries (${n_entries}) and snippets (${n_snippets})")
+  math(EXPR n_expected_entries "${n_snippets}+${n_critical_path_targets}")
+  if (NOT n_entries EQUAL n_expected_entries)
+    add_error("Differing number of trace entries (${n_entries}) and snippets (${n_snippets}) with critical path targets (${n_critical_path_targets})")
   endif()
 
   math(EXPR entries_range "${n_entries}-1")
   foreach (i RANGE ${entries_range})
     string(JSON entry GET "${trace_contents}" ${i})
+    string(JSON cat GET "${entry}" cat)
+    if (cat STREQUAL "criticalPath")
+      trace_entry_has_fields("${trace}" "${entry}")
+      continue()
+    endif()
     verify_trace_entry("${trace}" "${entry}")
 
     # In addition to validating the data in the trace entry, check that
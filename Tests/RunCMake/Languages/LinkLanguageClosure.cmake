@@ -0,0 +1,17 @@
+enable_language(C)
+enable_language(CXX)
+
+# E is defined first so that its link closure is computed first.  It
+# reaches C through the interface of L, which C itself links privately.
+add_executable(E empty.c)
+target_link_libraries(E PRIVATE L)
+
+add_library(D STATIC empty.cpp)
+add_library(L STATIC empty.c)
+target_link_libraries(L INTERFACE C)
+add_library(C SHARED empty.c)
+target_link_libraries(C PRIVATE L INTERFACE D)
+
+# C reaches D only through its own interface, so it links as C, not CXX.
+target_link_options(C PRIVATE
+  "$<$<LINK_LANGUAGE:CXX>:$<TARGET_PROPERTY:C_must_not_link_as_CXX,NAME>>")
@@ -0,0 +1,40 @@
+set(have_plain-Debug PLAIN_DEF PLAIN_OPT)
+set(have_plain-Release PLAIN_DEF PLAIN_OPT)
+set(have_mixed-Debug MIXED_DEF CONFIG_DEF_Debug DEBUG_ONLY_DEF MIXED_OPT)
+set(lack_mixed-Debug CONFIG_DEF_Release RELEASE_ONLY_OPT)
+set(have_mixed-Release MIXED_DEF CONFIG_DEF_Release MIXED_OPT RELEASE_ONLY_OPT)
+set(lack_mixed-Release CONFIG_DEF_Debug DEBUG_ONLY_DEF)
+set(have_linked-Debug LINKED_DEF IFACE_DEF_Debug)
+set(lack_linked-Debug IFACE_DEF_Release)
+set(have_linked-Release LINKED_DEF IFACE_DEF_Release)
+set(lack_linked-Release IFACE_DEF_Debug)
+
+file(READ "${RunCMake_TEST_BINARY_DIR}/compile_commands.json" compile_commands)
+string(JSON count LENGTH "${compile_commands}")
+math(EXPR last "${count} - 1")
+set(seen "")
+foreach(i RANGE ${last})
+  string(JSON command GET "${compile_commands}" ${i} command)
+  string(JSON output GET "${compile_commands}" ${i} output)
+  if(NOT output MATCHES "(^|/)CMakeFiles/([a-z]+)\\.dir/(Debug|Release)/")
+    continue()
+  endif()
+  set(key "${CMAKE_MATCH_2}-${CMAKE_MATCH_3}")
+  list(APPEND seen "${key}")
+  foreach(def IN LISTS have_${key})
+    if(NOT command MATCHES "[-/]D${def}( |$)")
+      string(APPEND RunCMake_TEST_FAILED "Compile command for ${key} does not define ${def}:\n  ${command}\n")
+    endif()
+  endforeach()
+  foreach(def IN LISTS lack_${key})
+    if(command MATCHES "[-/]D${def}( |$)")
+      string(APPEND RunCMake_TEST_FAILED "Compile command for ${key} defines ${def}:\n  ${command}\n")
+    endif()
+  endforeach()
+endforeach()
+
+list(SORT seen)
+set(expected_seen linked-Debug linked-Release mixed-Debug mixed-Release plain-Debug plain-Release)
+if(NOT seen STREQUAL expected_seen)
+  string(APPEND RunCMake_TEST_FAILED "Compile commands found for\n  ${seen}\nbut expected\n  ${expected_seen}\n")
+endif()
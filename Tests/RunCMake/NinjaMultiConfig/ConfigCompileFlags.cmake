@@ -0,0 +1,22 @@
+set(CMAKE_INTERMEDIATE_DIR_STRATEGY FULL CACHE STRING "" FORCE)
+
+enable_language(C)
+
+# Compile definitions and options that do not depend on the configuration
+# are computed once and shared by all configurations.  Those that do, or
+# that come from dependencies that do, must differ between them.
+add_executable(plain main.c)
+target_compile_definitions(plain PRIVATE PLAIN_DEF)
+target_compile_options(plain PRIVATE -DPLAIN_OPT)
+
+add_executable(mixed main.c)
+target_compile_definitions(mixed PRIVATE
+  MIXED_DEF CONFIG_DEF_$<CONFIG> $<$<CONFIG:Debug>:DEBUG_ONLY_DEF>)
+target_compile_options(mixed PRIVATE
+  -DMIXED_OPT $<$<CONFIG:Release>:-DRELEASE_ONLY_OPT>)
+
+add_library(iface INTERFACE)
+target_compile_definitions(iface INTERFACE IFACE_DEF_$<CONFIG>)
+add_executable(linked main.c)
+target_compile_definitions(linked PRIVATE LINKED_DEF)
+target_link_libraries(linked PRIVATE iface)
@@ -0,0 +1,33 @@
+set(CMAKE_INTERMEDIATE_DIR_STRATEGY FULL CACHE STRING "" FORCE)
+
+enable_language(C)
+
+# Simulate the dependencies recorded by a previous build of the target.
+# The headers are outside of the project's source and binary trees.
+set(external "${CMAKE_BINARY_DIR}/../PchAuto-external")
+file(WRITE "${external}/ext/common.h" "")
+file(WRITE "${external}/ext/rare.h" "")
+file(WRITE "${CMAKE_BINARY_DIR}/local.h" "")
+
+set(srcs "")
+set(deps "")
+foreach(s RANGE 1 4)
+  set(src "${CMAKE_BINARY_DIR}/s${s}.c")
+  set(content "#include \"local.h\"\n#include <ext/common.h>\n")
+  string(APPEND deps "CMakeFiles/foo.dir/s${s}.c.o\n"
+    " ${src}\n ${CMAKE_BINARY_DIR}/local.h\n ${external}/ext/common.h\n")
+  if(s EQUAL 1)
+    string(APPEND content "#include <ext/rare.h>\n")
+    string(APPEND deps " ${external}/ext/rare.h\n")
+  endif()
+  string(APPEND content "int s${s}(void) { return 0; }\n")
+  string(APPEND deps "\n")
+  file(WRITE "${src}" "${content}")
+  list(APPEND srcs "${src}")
+endforeach()
+file(WRITE "${CMAKE_BINARY_DIR}/CMakeFiles/foo.dir/compiler_depend.internal"
+  "${deps}")
+
+set(CMAKE_PRECOMPILE_HEADERS_AUTO ON)
+add_library(foo STATIC ${srcs})
+target_include_directories(foo PRIVATE "${external}")
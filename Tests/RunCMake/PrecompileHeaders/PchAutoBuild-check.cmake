@@ -0,0 +1,4 @@
+set(foo_pch_header "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/foo.dir/cmake_pch.h")
+if(EXISTS "${foo_pch_header}")
+  set(RunCMake_TEST_FAILED "Generated foo pch header ${foo_pch_header} exists before the first build")
+endif()
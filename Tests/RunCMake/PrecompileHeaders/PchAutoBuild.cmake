@@ -0,0 +1,30 @@
+set(CMAKE_INTERMEDIATE_DIR_STRATEGY FULL CACHE STRING "" FORCE)
+
+enable_language(C)
+
+# A header outside of the project's source and binary trees.
+set(external "${CMAKE_BINARY_DIR}/../PchAutoBuild-external")
+file(CONFIGURE OUTPUT "${external}/ext/common.h"
+  CONTENT "#define EXT_COMMON 1\n")
+
+# Headers in the binary and source trees are included by every source
+# too, but they are likely to change and must not be selected.
+file(CONFIGURE OUTPUT "${CMAKE_BINARY_DIR}/generated.h"
+  CONTENT "#define GENERATED 1\n")
+
+set(srcs "")
+foreach(s RANGE 1 4)
+  set(src "${CMAKE_BINARY_DIR}/s${s}.c")
+  file(CONFIGURE OUTPUT "${src}" CONTENT [[
+#include <ext/common.h>
+#include "generated.h"
+#include "PchAutoBuild/source.h"
+int s@s@(void) { return EXT_COMMON + GENERATED + SOURCE; }
+]] @ONLY)
+  list(APPEND srcs "${src}")
+endforeach()
+
+set(CMAKE_PRECOMPILE_HEADERS_AUTO ON)
+add_library(foo STATIC ${srcs})
+target_include_directories(foo PRIVATE
+  "${external}" "${CMAKE_BINARY_DIR}" "${CMAKE_SOURCE_DIR}")
@@ -0,0 +1 @@
+#define SOURCE 1
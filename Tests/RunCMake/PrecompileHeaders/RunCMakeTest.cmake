@@ -27,6 +27,24 @@ run_cmake(PchPrologueEpilogue)
 run_test(SkipPrecompileHeaders)
 run_test(CXXnotC)
 run_cmake(PchMultilanguage)
+if(RunCMake_GENERATOR MATCHES "Make")
+  run_cmake(PchAuto)
+
+  # Select the headers from a real build, and keep the selection when
+  # configuring again after the generator dropped the dependencies.
+  block()
+    set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/PchAutoBuild-build)
+    run_cmake(PchAutoBuild)
+    set(RunCMake_TEST_NO_CLEAN 1)
+    # The dependencies generated by the compiler are only collected by
+    # the build that follows the one that compiled the sources.
+    run_cmake_command(PchAutoBuild-build ${CMAKE_COMMAND} --build .)
+    run_cmake_command(PchAutoBuild-build2 ${CMAKE_COMMAND} --build .)
+    run_cmake_command(PchAutoBuild-reconfigure ${CMAKE_COMMAND} .)
+    run_cmake_command(PchAutoBuild-reconfigure2 ${CMAKE_COMMAND} .)
+    run_cmake_command(PchAutoBuild-rebuild ${CMAKE_COMMAND} --build .)
+  endblock()
+endif()
 if(RunCMake_GENERATOR MATCHES "Make|Ninja")
   run_cmake(PchWarnInvalid)
 
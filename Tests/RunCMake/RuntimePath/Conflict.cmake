@@ -0,0 +1,28 @@
+enable_language(C)
+
+# Each library is hidden by a file of the same name in the directory of
+# the other, so no runtime search path order finds both.
+set(libs A B)
+if(extra)
+  foreach(i RANGE 1 ${extra})
+    list(APPEND libs E${i})
+  endforeach()
+endif()
+foreach(lib IN LISTS libs)
+  if(lib STREQUAL "B")
+    set(dir b)
+  else()
+    set(dir a)
+  endif()
+  file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/${dir}/lib${lib}.so" "")
+  add_library(${lib} SHARED IMPORTED)
+  set_target_properties(${lib} PROPERTIES
+    IMPORTED_LOCATION "${CMAKE_CURRENT_BINARY_DIR}/${dir}/lib${lib}.so"
+    IMPORTED_SONAME "lib${lib}.so"
+    )
+endforeach()
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/a/libB.so" "")
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/b/libA.so" "")
+
+add_executable(main main.c)
+target_link_libraries(main PRIVATE ${libs})
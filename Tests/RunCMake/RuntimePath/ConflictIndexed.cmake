@@ -0,0 +1,3 @@
+# With enough libraries the content of the directories is indexed.
+set(extra 10)
+include(${CMAKE_CURRENT_LIST_DIR}/Conflict.cmake)
@@ -33,6 +33,9 @@ if(CMAKE_EXECUTABLE_FORMAT STREQUAL "ELF")
     ${CMAKE_COMMAND} -Ddir=${RunCMake_BINARY_DIR}/Genex-build -P ${RunCMake_SOURCE_DIR}/GenexCheck.cmake)
 
   run_RuntimePath(SysrootSlash)
+
+  run_cmake(Conflict)
+  run_cmake(ConflictIndexed)
 endif()
 
 block()
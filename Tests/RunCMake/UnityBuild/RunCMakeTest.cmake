@@ -41,6 +41,9 @@ if(CMake_TEST_CUDA)
 endif()
 run_cmake(unitybuild_batchsize)
 run_cmake(unitybuild_default_batchsize)
+run_cmake(unitybuild_c_cost)
+run_cmake(unitybuild_c_cost_mixed)
+run_cmake(unitybuild_c_cost_invalid)
 run_cmake(unitybuild_skip)
 run_cmake(unitybuild_fileset_skip)
 run_cmake(unitybuild_code_before_and_after_include)
@@ -0,0 +1,25 @@
+set(expected_0 s2 s5 s6 s8)
+set(expected_1 s3 s4 s7)
+foreach(batch 0 1)
+  set(unitybuild_c "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/tgt.dir/Unity/unity_${batch}_c.c")
+  if(NOT EXISTS "${unitybuild_c}")
+    set(RunCMake_TEST_FAILED "Generated unity source files ${unitybuild_c} does not exist.")
+    return()
+  endif()
+  file(STRINGS ${unitybuild_c} unitybuild_c_strings REGEX "#include")
+  set(actual "")
+  foreach(line IN LISTS unitybuild_c_strings)
+    string(REGEX REPLACE ".*/(s[0-9]+)\\.c\"$" "\\1" src "${line}")
+    list(APPEND actual "${src}")
+  endforeach()
+  if(NOT actual STREQUAL expected_${batch})
+    set(RunCMake_TEST_FAILED "Generated unity source file ${unitybuild_c} includes\n  ${actual}\nbut expected\n  ${expected_${batch}}")
+    return()
+  endif()
+endforeach()
+
+set(unitybuild_c2 "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/tgt.dir/Unity/unity_2_c.c")
+if(EXISTS "${unitybuild_c2}")
+  set(RunCMake_TEST_FAILED "Generated unity source file ${unitybuild_c2} should not exist.")
+  return()
+endif()
@@ -0,0 +1,26 @@
+set(CMAKE_INTERMEDIATE_DIR_STRATEGY FULL CACHE STRING "" FORCE)
+
+project(unitybuild_c_cost C)
+
+set(srcs "")
+foreach(s RANGE 1 8)
+  set(src "${CMAKE_CURRENT_BINARY_DIR}/s${s}.c")
+  file(WRITE "${src}" "int s${s}(void) { return 0; }\n")
+  list(APPEND srcs "${src}")
+endforeach()
+
+add_library(tgt SHARED ${srcs})
+
+set_target_properties(tgt
+  PROPERTIES
+    UNITY_BUILD ON
+    UNITY_BUILD_MODE COST
+    UNITY_BUILD_BATCH_SIZE 4
+)
+
+set_source_files_properties(s1.c PROPERTIES UNITY_COST 50)
+set_source_files_properties(s2.c PROPERTIES UNITY_COST 6)
+set_source_files_properties(s3.c PROPERTIES UNITY_COST 5)
+set_source_files_properties(s4.c PROPERTIES UNITY_COST 4)
+set_source_files_properties(s5.c PROPERTIES UNITY_COST 3)
+set_source_files_properties(s6.c s7.c s8.c PROPERTIES UNITY_COST 1)
@@ -0,0 +1,23 @@
+set(CMAKE_INTERMEDIATE_DIR_STRATEGY FULL CACHE STRING "" FORCE)
+
+project(unitybuild_c_cost_invalid C)
+
+set(srcs "")
+foreach(s RANGE 1 4)
+  set(src "${CMAKE_CURRENT_BINARY_DIR}/s${s}.c")
+  file(WRITE "${src}" "int s${s}(void) { return 0; }\n")
+  list(APPEND srcs "${src}")
+endforeach()
+
+add_library(tgt SHARED ${srcs})
+
+set_target_properties(tgt
+  PROPERTIES
+    UNITY_BUILD ON
+    UNITY_BUILD_MODE COST
+    UNITY_BUILD_BATCH_SIZE 2
+)
+
+set_source_files_properties(s1.c s2.c PROPERTIES UNITY_COST 1)
+set_source_files_properties(s3.c PROPERTIES UNITY_COST large)
+set_source_files_properties(s4.c PROPERTIES UNITY_COST -3)
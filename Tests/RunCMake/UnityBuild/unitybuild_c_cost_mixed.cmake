@@ -0,0 +1,26 @@
+set(CMAKE_INTERMEDIATE_DIR_STRATEGY FULL CACHE STRING "" FORCE)
+
+project(unitybuild_c_cost_mixed C)
+
+# Sources without UNITY_COST are large on disk, but their size must not
+# be compared with the explicit costs of the other sources.
+string(REPEAT "/* padding */\n" 1000 padding)
+set(srcs "")
+foreach(s RANGE 1 7)
+  set(src "${CMAKE_CURRENT_BINARY_DIR}/s${s}.c")
+  file(WRITE "${src}" "${padding}int s${s}(void) { return 0; }\n")
+  list(APPEND srcs "${src}")
+endforeach()
+
+add_library(tgt SHARED ${srcs})
+
+set_target_properties(tgt
+  PROPERTIES
+    UNITY_BUILD ON
+    UNITY_BUILD_MODE COST
+    UNITY_BUILD_BATCH_SIZE 2
+)
+
+# s4 through s7 are assumed to cost the mean of these, 34.
+set_source_files_properties(s1.c PROPERTIES UNITY_COST 100)
+set_source_files_properties(s2.c s3.c PROPERTIES UNITY_COST 1)
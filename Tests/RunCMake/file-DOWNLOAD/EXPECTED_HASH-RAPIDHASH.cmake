@@ -0,0 +1,4 @@
+include(common.cmake)
+
+# A non-cryptographic hash cannot verify a download.
+file_download(EXPECTED_HASH RAPIDHASH=0123456789abcdef)
@@ -20,6 +20,8 @@ run_cmake(bad-file)
 
 run_cmake(basic)
 run_cmake(EXPECTED_HASH)
+run_cmake(EXPECTED_HASH-RAPIDHASH)
+run_cmake(download-cache)
 run_cmake(file-without-path)
 run_cmake(no-file)
 run_cmake(range)
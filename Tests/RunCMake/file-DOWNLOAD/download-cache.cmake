@@ -0,0 +1,45 @@
+include(common.cmake)
+
+set(hash cf3334b1275071e1da6e8c396ccb72cf1b2388d8c937526f3af26230affb9423)
+set(CMAKE_DOWNLOAD_CACHE "${CMAKE_CURRENT_BINARY_DIR}/cache")
+file(REMOVE_RECURSE "${CMAKE_DOWNLOAD_CACHE}")
+file(REMOVE "${file}")
+
+# Download the file and add it to the cache.
+file_download(EXPECTED_HASH SHA256=${hash})
+if(NOT EXISTS "${CMAKE_DOWNLOAD_CACHE}/SHA256/${hash}")
+  message(SEND_ERROR "Download was not added to the cache.")
+endif()
+
+# Satisfy the download from the cache without accessing the URL.
+file(REMOVE "${file}")
+set(url "file://${slash}${CMAKE_CURRENT_SOURCE_DIR}/does-not-exist.png")
+file_download(EXPECTED_HASH SHA256=${hash})
+file(SHA256 "${file}" actual)
+if(NOT actual STREQUAL hash)
+  message(SEND_ERROR "File from the cache has hash:\n  ${actual}")
+endif()
+
+# Modifying the file does not modify the cache entry.
+file(APPEND "${file}" "modified")
+file(SHA256 "${CMAKE_DOWNLOAD_CACHE}/SHA256/${hash}" actual)
+if(NOT actual STREQUAL hash)
+  message(SEND_ERROR "Modifying the file modified the cache entry.")
+endif()
+
+# A corrupt cache entry is replaced by a fresh download.
+file(REMOVE "${file}")
+file(WRITE "${CMAKE_DOWNLOAD_CACHE}/SHA256/${hash}" "corrupt")
+set(url "file://${slash}${CMAKE_CURRENT_SOURCE_DIR}/input.png")
+file_download(EXPECTED_HASH SHA256=${hash})
+file(SHA256 "${CMAKE_DOWNLOAD_CACHE}/SHA256/${hash}" actual)
+if(NOT actual STREQUAL hash)
+  message(SEND_ERROR "Corrupt cache entry was not replaced.")
+endif()
+
+# An existing file with the expected hash populates an empty cache.
+file(REMOVE_RECURSE "${CMAKE_DOWNLOAD_CACHE}")
+file_download(EXPECTED_HASH SHA256=${hash})
+if(NOT EXISTS "${CMAKE_DOWNLOAD_CACHE}/SHA256/${hash}")
+  message(SEND_ERROR "Existing file was not added to the cache.")
+endif()
@@ -76,6 +76,7 @@ elseif(CMAKE_HOST_SYSTEM_NAME STREQUAL "Linux" OR CMAKE_HOST_SYSTEM_NAME STREQUA
   run_install_test(linux-conflict)
   run_install_test(linux-notfile)
   run_install_test(linux-indirect-dependencies)
+  run_install_test(linux-builtin)
   run_cmake(project)
   run_cmake(badargs1)
   run_cmake(badargs2)
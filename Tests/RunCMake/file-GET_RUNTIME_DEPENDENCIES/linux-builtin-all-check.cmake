@@ -0,0 +1,30 @@
+# The builtin tool must resolve exactly what the objdump tool resolves.
+foreach(kind IN ITEMS resolved unresolved)
+  file(READ "${CMAKE_INSTALL_PREFIX}/deps/builtin-${kind}.txt" builtin)
+  file(READ "${CMAKE_INSTALL_PREFIX}/deps/objdump-${kind}.txt" objdump)
+  if(NOT builtin STREQUAL objdump)
+    string(APPEND RunCMake_TEST_FAILED "The builtin tool ${kind}:\n  ${builtin}\n"
+      "does not match the objdump tool:\n  ${objdump}\n")
+  endif()
+endforeach()
+
+# The C library is found through the ld.so cache, where there is one.
+file(READ "${CMAKE_INSTALL_PREFIX}/deps/builtin-resolved.txt" resolved)
+set(libc "${resolved}")
+list(FILTER libc INCLUDE REGEX "/libc\\.so\\.6$")
+list(FILTER resolved EXCLUDE REGEX "/libc\\.so\\.6$")
+list(LENGTH libc n)
+if(EXISTS "/etc/ld.so.cache" AND NOT n EQUAL 1)
+  string(APPEND RunCMake_TEST_FAILED "libc.so.6 was not resolved exactly once:\n  ${libc}\n")
+endif()
+
+set(_check
+  [[[^;]*/Tests/RunCMake/file-GET_RUNTIME_DEPENDENCIES/linux-builtin-build/libA/libA\.so]]
+  [[[^;]*/Tests/RunCMake/file-GET_RUNTIME_DEPENDENCIES/linux-builtin-build/libB/libB\.so]]
+  [[[^;]*/Tests/RunCMake/file-GET_RUNTIME_DEPENDENCIES/linux-builtin-build/libC/libC\.so]]
+  )
+if(NOT resolved MATCHES "^${_check}$")
+  string(APPEND RunCMake_TEST_FAILED "Resolved dependencies:\n  ${resolved}\n"
+    "do not match what we expected:\n  ${_check}\n")
+endif()
+check_contents(deps/builtin-unresolved.txt "^libD\\.so$")
@@ -0,0 +1,63 @@
+enable_language(C)
+cmake_policy(SET CMP0095 NEW)
+
+file(WRITE "${CMAKE_BINARY_DIR}/A.c" "void libA(void) {}\n")
+file(WRITE "${CMAKE_BINARY_DIR}/C.c" "void libC(void) {}\n")
+file(WRITE "${CMAKE_BINARY_DIR}/D.c" "void libD(void) {}\n")
+file(WRITE "${CMAKE_BINARY_DIR}/BUseAC.c" [[
+extern void libA(void);
+extern void libC(void);
+void libB(void)
+{
+    libA();
+    libC();
+}
+]])
+file(WRITE "${CMAKE_BINARY_DIR}/mainBD.c" [[
+extern void libB(void);
+extern void libD(void);
+
+int main(void)
+{
+    libB();
+    libD();
+    return 0;
+}
+]])
+
+foreach(lib IN ITEMS A B C D)
+  if(lib STREQUAL "B")
+    add_library(B SHARED "${CMAKE_BINARY_DIR}/BUseAC.c")
+  else()
+    add_library(${lib} SHARED "${CMAKE_BINARY_DIR}/${lib}.c")
+  endif()
+  set_property(TARGET ${lib} PROPERTY
+    LIBRARY_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/lib${lib}")
+endforeach()
+
+# B finds its dependencies through DT_RPATH, and the executable finds its
+# own through DT_RUNPATH.
+target_link_libraries(B PRIVATE A C)
+target_link_options(B PRIVATE -Wl,--disable-new-dtags)
+add_executable(exe "${CMAKE_BINARY_DIR}/mainBD.c")
+target_link_libraries(exe PRIVATE B D)
+target_link_options(exe PRIVATE -Wl,--enable-new-dtags)
+
+install(CODE [[
+  # Remove D so that it cannot be resolved.
+  file(REMOVE "$<TARGET_FILE:D>")
+
+  # Resolve the same files with the builtin tool and with objdump.
+  foreach(tool IN ITEMS builtin objdump)
+    set(CMAKE_GET_RUNTIME_DEPENDENCIES_TOOL ${tool})
+    file(GET_RUNTIME_DEPENDENCIES
+      RESOLVED_DEPENDENCIES_VAR resolved
+      UNRESOLVED_DEPENDENCIES_VAR unresolved
+      PRE_INCLUDE_REGEXES "^lib[ABCD]\\.so$" "^libc\\.so\\.6$"
+      PRE_EXCLUDE_REGEXES ".*"
+      EXECUTABLES "$<TARGET_FILE:exe>"
+      )
+    file(WRITE "${CMAKE_INSTALL_PREFIX}/deps/${tool}-resolved.txt" "${resolved}")
+    file(WRITE "${CMAKE_INSTALL_PREFIX}/deps/${tool}-unresolved.txt" "${unresolved}")
+  endforeach()
+  ]])
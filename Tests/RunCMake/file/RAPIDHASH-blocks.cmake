@@ -0,0 +1,14 @@
+# Content spanning several RAPIDHASH blocks must hash the same whether it
+# is streamed from a file or given as one string.
+string(REPEAT "0123456789abcdef" 163840 data)
+string(APPEND data "tail")
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/blocks.txt" "${data}")
+file(RAPIDHASH "${CMAKE_CURRENT_BINARY_DIR}/blocks.txt" file_hash)
+string(RAPIDHASH string_hash "${data}")
+if(NOT file_hash STREQUAL string_hash)
+  message(SEND_ERROR "file(RAPIDHASH) gave\n  ${file_hash}\n"
+    "but string(RAPIDHASH) gave\n  ${string_hash}")
+endif()
+if(NOT file_hash MATCHES "^[0-9a-f]+$" OR NOT file_hash MATCHES "^................$")
+  message(SEND_ERROR "Unexpected hash format:\n  ${file_hash}")
+endif()
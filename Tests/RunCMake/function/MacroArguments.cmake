@@ -0,0 +1,31 @@
+# Macro parameters are replaced textually in the recorded body.
+macro(show a b)
+  message(STATUS "ARGC=${ARGC} ARGV=[${ARGV}] ARGN=[${ARGN}]")
+  message(STATUS "ARGV0=[${ARGV0}] ARGV1=[${ARGV1}] ARGV2=[${ARGV2}]")
+  message(STATUS "a=[${a}] b=[${b}] quoted=\"${a}-${b}\"")
+  message(STATUS [[bracket ${a} ${ARGN}]])
+  message(STATUS "plain text")
+  foreach(arg IN ITEMS ${ARGN})
+    message(STATUS "ARGN item [${arg}]")
+  endforeach()
+endmacro()
+
+show(1 2)
+show(x "y;z" 3 "" 4)
+
+# Substitutions are applied one parameter after the other, so a value
+# that contains the name of a later parameter is substituted again.
+macro(names first second)
+  message(STATUS "first=[${first}] second=[${second}] ARGN=[${ARGN}]")
+endmacro()
+names("\${second}" "\${first}" "\${ARGC}")
+names(first "\${ARGN}" extra)
+
+# A macro reads ${ARGV<n>} beyond ARGC from the calling scope.
+function(outer)
+  macro(inner)
+    message(STATUS "inner ARGC=${ARGC} ARGV0=[${ARGV0}] ARGV1=[${ARGV1}]")
+  endmacro()
+  inner(only)
+endfunction()
+outer(o1 o2)
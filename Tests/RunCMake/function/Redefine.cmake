@@ -0,0 +1,18 @@
+# The same call site must see a command redefined between its executions.
+function(greet)
+  message(STATUS "greet 1")
+endfunction()
+
+foreach(i RANGE 1 3)
+  greet()
+  if(i EQUAL 1)
+    function(greet)
+      message(STATUS "greet 2")
+      _greet()
+    endfunction()
+  elseif(i EQUAL 2)
+    macro(greet)
+      message(STATUS "greet 3")
+    endmacro()
+  endif()
+endforeach()
@@ -0,0 +1,37 @@
+# A command redefined by its own body finishes executing its original
+# definition, and later calls run the new one.  The parameters of a macro
+# are also substituted in the body of a macro it defines.
+function(fn)
+  message(STATUS "fn original ${ARGV0}")
+  function(fn)
+    message(STATUS "fn redefined ${ARGV0}")
+  endfunction()
+  message(STATUS "fn original still running ${ARGV0}")
+endfunction()
+fn(a)
+fn(b)
+
+macro(mac arg)
+  message(STATUS "mac original ${arg}")
+  macro(mac arg)
+    message(STATUS "mac redefined ${arg}")
+  endmacro()
+  message(STATUS "mac original still running ${arg}")
+endmacro()
+mac(a)
+mac(b)
+
+# Recursion through a macro that redefines itself on the way down.
+macro(countdown n)
+  message(STATUS "countdown ${n}")
+  if(${n} GREATER 0)
+    math(EXPR next "${n} - 1")
+    if(${n} EQUAL 2)
+      macro(countdown n)
+        message(STATUS "replacement ${n}")
+      endmacro()
+    endif()
+    countdown(${next})
+  endif()
+endmacro()
+countdown(3)
@@ -1,3 +1,6 @@
 include(RunCMake)
 
 run_cmake(CMAKE_CURRENT_FUNCTION)
+run_cmake_script(Redefine)
+run_cmake_script(MacroArguments)
+run_cmake_script(RedefineWhileExecuting)
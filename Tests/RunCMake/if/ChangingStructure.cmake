@@ -0,0 +1,25 @@
+# The same if() call site evaluates conditions whose structure depends on
+# the values of the variables in it.
+set(conditions
+  "1"
+  "0 OR 1"
+  "NOT 1"
+  "( 0 OR 1 ) AND NOT ( 1 AND 0 )"
+  "abc MATCHES ^a(.)c$ AND CMAKE_MATCH_1 STREQUAL b"
+  "2 GREATER 10"
+  "1.10 VERSION_GREATER 1.9"
+  "NOT 0 AND NOT 1"
+  "OFF"
+  )
+foreach(pass 1 2)
+  set(results)
+  foreach(condition IN LISTS conditions)
+    string(REPLACE " " ";" args "${condition}")
+    if(${args})
+      list(APPEND results 1)
+    else()
+      list(APPEND results 0)
+    endif()
+  endforeach()
+  message(STATUS "results: ${results}")
+endforeach()
@@ -30,3 +30,5 @@ run_cmake(TestNameThatExists)
 run_cmake(TestNameThatDoesNotExist)
 
 run_cmake_script(AndOr)
+
+run_cmake_script(ChangingStructure)
@@ -0,0 +1,62 @@
+# Appending in a function must not modify the parent scope's value.
+set(list a)
+function(append_local)
+  list(APPEND list b)
+  list(APPEND list c)
+  if(NOT list STREQUAL "a;b;c")
+    message(SEND_ERROR "Function scope list is '${list}', not 'a;b;c'")
+  endif()
+  string(APPEND list "d")
+  if(NOT list STREQUAL "a;b;cd")
+    message(SEND_ERROR "Function scope string is '${list}', not 'a;b;cd'")
+  endif()
+endfunction()
+append_local()
+if(NOT list STREQUAL "a")
+  message(SEND_ERROR "Parent scope list is '${list}', not 'a'")
+endif()
+
+# Appending to an empty or undefined variable does not add a separator.
+set(empty "")
+list(APPEND empty x)
+list(APPEND undefined x)
+if(NOT empty STREQUAL "x" OR NOT undefined STREQUAL "x")
+  message(SEND_ERROR "Unexpected values '${empty}' and '${undefined}'")
+endif()
+
+# Appending to a cache entry starts from the cached value.
+set(cached "a;b" CACHE INTERNAL "")
+list(APPEND cached c)
+if(NOT cached STREQUAL "a;b;c")
+  message(SEND_ERROR "Cache-initialized list is '${cached}', not 'a;b;c'")
+endif()
+set(cached_str "x" CACHE INTERNAL "")
+string(APPEND cached_str "y")
+if(NOT cached_str STREQUAL "xy")
+  message(SEND_ERROR "Cache-initialized string is '${cached_str}', not 'xy'")
+endif()
+
+# Watched variables see the appended value.
+function(watch var access value)
+  if(access STREQUAL "MODIFIED_ACCESS")
+    set_property(GLOBAL APPEND PROPERTY watched "${value}")
+  endif()
+endfunction()
+set(watched a)
+variable_watch(watched watch)
+list(APPEND watched b)
+get_property(seen GLOBAL PROPERTY watched)
+if(NOT seen STREQUAL "a;b")
+  message(SEND_ERROR "Watch saw '${seen}', not 'a;b'")
+endif()
+
+# Build a long list by appending one item at a time.
+set(long "")
+foreach(i RANGE 1 20000)
+  list(APPEND long item${i})
+endforeach()
+list(LENGTH long n)
+list(GET long -1 last)
+if(NOT n EQUAL 20000 OR NOT last STREQUAL "item20000")
+  message(SEND_ERROR "Long list has ${n} items ending in '${last}'")
+endif()
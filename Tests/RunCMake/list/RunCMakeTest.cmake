@@ -109,6 +109,8 @@ run_cmake(TRANSFORM-PREDICATE)
 run_cmake(TRANSFORM-PREDICATE-Reentrant)
 run_cmake(CMP0186)
 
+run_cmake_script(APPEND-scopes)
+
 # argument tests
 run_cmake(SORT-WrongOption)
 run_cmake(SORT-BadCaseOption)